@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+    CacheLayoutBenchmark.cpp
+    Created: 18 Oct 2026 4:12:26pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Compares the old DelayAudioProcessor layout (per-sample state spread between large members,
+// meter atomics next to it) with the per-sample state packed into one aligned struct and the
+// BlockStatsQueue. DelayEngine keeps its state in separate members: the packed layout only pays
+// for itself with L1D miss counts to show for it, which the machines it was tried on couldn't
+// count, and its timings there went both ways from run to run.
+//
+// Every block first streams through more memory than L1 holds, like the delay lines and the
+// scratch buffer do, then runs a control loop shaped like updateControlValues() and updates
+// the meters. A second thread keeps reading the meters like the editor's timer does. On Linux the
+// L1 data cache read misses of the control loop are counted with perf_event_open; elsewhere,
+// or when there's no such counter or perf is not allowed (see /proc/sys/kernel/perf_event_paranoid),
+// only the time is shown, with the reason.
+//
+//   BrocDelayCacheLayoutBenchmark [blocks] [blockSize]
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../Source/CacheLine.h"
+#include "../Source/BlockStats.h"
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    // keeps the compiler from optimising the loops away
+    volatile float resultSink = 0.0f;
+
+    // Counts user space L1 data cache read misses of the calling thread
+    class L1MissCounter
+    {
+    public:
+        L1MissCounter()
+        {
+           #if defined(__linux__)
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D
+                        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                error = 0;
+            } else {
+                error = errno;
+            }
+           #endif
+        }
+
+        ~L1MissCounter()
+        {
+           #if defined(__linux__)
+            if (fd >= 0) {
+                close(fd);
+            }
+           #endif
+        }
+
+        // Why the counter isn't available, for the report
+        const char* getError() const noexcept
+        {
+            switch (error) {
+                case 0:
+                    return nullptr;
+                case EACCES:
+                case EPERM:
+                    return "perf_event_paranoid doesn't allow it";
+                case ENOENT:
+                case EOPNOTSUPP:
+                    return "no L1D miss counter on this CPU or virtual machine";
+                case ENOSYS:
+                    return "no perf events on this system";
+                default:
+                    return std::strerror(error);
+            }
+        }
+
+        void start() noexcept
+        {
+           #if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+           #endif
+        }
+
+        void stop() noexcept
+        {
+           #if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+           #endif
+        }
+
+        std::uint64_t read() const noexcept
+        {
+            std::uint64_t count = 0;
+           #if defined(__linux__)
+            if (fd >= 0 && ::read(fd, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+           #endif
+            return count;
+        }
+
+    private:
+        int fd = -1;
+        int error = ENOSYS;
+    };
+
+    // The meter as it used to be: an atomic per channel with a CAS loop on the audio thread
+    struct OldMeasurement
+    {
+        void updateIfGreater(float newValue) noexcept
+        {
+            auto oldValue = value.load();
+            while (newValue > oldValue && !value.compare_exchange_weak(oldValue, newValue));
+        }
+
+        float readAndReset() noexcept { return value.exchange(0.0f); }
+
+        std::atomic<float> value { 0.0f };
+    };
+
+    // The members in the order the processor used to declare them; the byte arrays stand in
+    // for apvts, params, the delay lines, Tempo and the juce::dsp filters
+    struct ScatteredLayout
+    {
+        char apvts[480];
+        char params[400];
+        OldMeasurement levelL, levelR;
+        char delayLines[48];
+        float feedbackL = 0.0f, feedbackR = 0.0f;
+        char filters[360];
+        float lastLowCut = -1.0f, lastHighCut = -1.0f;
+        float lowCutG = 0.0f, lowCutH = 0.0f, highCutG = 0.0f, highCutH = 0.0f;
+        float lastMix = -1.0f, dryGain = 1.0f, wetGain = 0.0f;
+        char tempo[136];
+        float delayInSamples = 0.0f, targetDelay = 0.0f;
+        char padding1[72];
+        float xfade = 0.0f, xfadeInc = 0.0f;
+        char padding2[96];
+        float duckFade = 1.0f, duckFadeTarget = 1.0f, duckCoeff = 0.0f, duckWait = 0.0f, duckWaitInc = 0.0f;
+        char padding3[88];
+        float tempoSyncCoeff = 0.0f;
+    };
+
+    struct PackedLayout
+    {
+        char apvts[480];
+        char params[400];
+        BlockStatsQueue blockStats;
+        char delayLines[48];
+        char tempo[136];
+
+        struct alignas(cacheLineSize) State
+        {
+            float delayInSamples = 0.0f, targetDelay = 0.0f;
+            float xfade = 0.0f, xfadeInc = 0.0f;
+            float duckFade = 1.0f, duckFadeTarget = 1.0f, duckCoeff = 0.0f, duckWait = 0.0f, duckWaitInc = 0.0f;
+            float tempoSyncCoeff = 0.0f;
+            float lastLowCut = -1.0f, lastHighCut = -1.0f;
+            float lowCutG = 0.0f, lowCutH = 0.0f, highCutG = 0.0f, highCutH = 0.0f;
+            float lastMix = -1.0f, dryGain = 1.0f, wetGain = 0.0f;
+            float feedbackL = 0.0f, feedbackR = 0.0f;
+        } state;
+    };
+
+    void publish(ScatteredLayout& layout, float peak) noexcept
+    {
+        layout.levelL.updateIfGreater(peak);
+        layout.levelR.updateIfGreater(-peak);
+    }
+
+    void publish(PackedLayout& layout, float peak) noexcept
+    {
+        layout.blockStats.push({ .samplePosition = 0, .numSamples = 0, .peakL = peak, .peakR = -peak,
+                                 .rmsL = 0.0f, .rmsR = 0.0f, .truePeakL = 0.0f, .truePeakR = 0.0f,
+                                 .processingTime = 0.0f });
+    }
+
+    float readMeters(ScatteredLayout& layout) noexcept
+    {
+        return layout.levelL.readAndReset() + layout.levelR.readAndReset();
+    }
+
+    float readMeters(PackedLayout& layout) noexcept
+    {
+        float sum = 0.0f;
+        layout.blockStats.drain([&] (const BlockStats& stats) { sum += stats.peakL + stats.peakR; });
+        return sum;
+    }
+
+    ScatteredLayout& hotState(ScatteredLayout& layout) { return layout; }
+    PackedLayout::State& hotState(PackedLayout& layout) { return layout.state; }
+
+    // The same branches and updates as updateControlValues(), with a made up automation curve
+    template <typename Layout>
+    float controlLoop(Layout& layout, const float* automation, int numSamples) noexcept
+    {
+        auto& s = hotState(layout);
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            float newTargetDelay = automation[i] * 48.0f;
+            if (s.xfade == 0.0f && newTargetDelay != s.targetDelay) {
+                s.targetDelay = newTargetDelay;
+                s.xfade = s.xfadeInc;
+            }
+            s.delayInSamples = (1.0f - s.tempoSyncCoeff) * s.delayInSamples + s.tempoSyncCoeff * s.targetDelay;
+
+            if (s.xfade > 0.0f) {
+                s.xfade += s.xfadeInc;
+                if (s.xfade >= 1.0f) {
+                    s.delayInSamples = s.targetDelay;
+                    s.xfade = 0.0f;
+                }
+            }
+
+            s.duckFade += (s.duckFadeTarget - s.duckFade) * s.duckCoeff;
+            if (s.duckWait > 0.0f) {
+                s.duckWait += s.duckWaitInc;
+            }
+
+            float lowCut = 20.0f + automation[i];
+            if (lowCut != s.lastLowCut) {
+                s.lowCutG = lowCut * 0.001f;
+                s.lowCutH = 1.0f / (1.0f + s.lowCutG);
+                s.lastLowCut = lowCut;
+            }
+            float highCut = 20000.0f - automation[i];
+            if (highCut != s.lastHighCut) {
+                s.highCutG = highCut * 0.0001f;
+                s.highCutH = 1.0f / (1.0f + s.highCutG);
+                s.lastHighCut = highCut;
+            }
+            if (automation[i] != s.lastMix) {
+                s.dryGain = 1.0f - automation[i];
+                s.wetGain = automation[i];
+                s.lastMix = automation[i];
+            }
+
+            s.feedbackL = s.feedbackL * 0.5f + s.lowCutH * s.dryGain;
+            s.feedbackR = s.feedbackR * 0.5f + s.highCutH * s.wetGain;
+            sum += s.delayInSamples + s.duckFade + s.feedbackL + s.feedbackR;
+        }
+        return sum;
+    }
+
+    struct Result
+    {
+        double nanosecondsPerBlock;
+        double missesPerBlock;
+        const char* counterError;  // nullptr when the misses were counted
+    };
+
+    template <typename Layout>
+    Result run(int numBlocks, int blockSize)
+    {
+        auto layout = std::make_unique<Layout>();
+        hotState(*layout).xfadeInc = 1.0f / 2400.0f;
+        hotState(*layout).tempoSyncCoeff = 0.001f;
+        hotState(*layout).duckCoeff = 0.001f;
+
+        std::vector<float> automation(static_cast<size_t>(blockSize));
+        for (int i = 0; i < blockSize; ++i) {
+            automation[size_t(i)] = float(i % 16) / 16.0f;
+        }
+
+        // bigger than any L1, smaller than L2, like a second of delay line plus the scratch buffer
+        std::vector<float> traffic(64 * 1024);
+
+        std::atomic<bool> running { true };
+        std::thread ui([&] {
+            float sink = 0.0f;
+            while (running.load(std::memory_order_relaxed)) {
+                sink += readMeters(*layout);
+            }
+            resultSink = sink;
+        });
+
+        L1MissCounter counter;
+
+        float sink = 0.0f;
+        std::chrono::nanoseconds elapsed { 0 };
+        for (int block = 0; block < numBlocks; ++block) {
+            for (size_t i = 0; i < traffic.size(); i += 16) {
+                traffic[i] += 1.0f;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            counter.start();
+            sink += controlLoop(*layout, automation.data(), blockSize);
+            publish(*layout, sink);
+            counter.stop();
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        running.store(false);
+        ui.join();
+
+        resultSink = sink;
+
+        return { double(elapsed.count()) / numBlocks, double(counter.read()) / numBlocks, counter.getError() };
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int numBlocks = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int blockSize = argc > 2 ? std::atoi(argv[2]) : 256;
+    if (numBlocks <= 0 || blockSize <= 0) {
+        std::fprintf(stderr, "usage: %s [blocks] [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    auto scattered = run<ScatteredLayout>(numBlocks, blockSize);
+    auto packed = run<PackedLayout>(numBlocks, blockSize);
+    bool countersAvailable = scattered.counterError == nullptr && packed.counterError == nullptr;
+
+    std::printf("%d blocks of %d samples, cache line %d bytes\n\n", numBlocks, blockSize, int(cacheLineSize));
+    std::printf("%-10s%14s%18s\n", "layout", "ns/block", "L1D misses/block");
+    std::printf("%-10s%14.1f", "scattered", scattered.nanosecondsPerBlock);
+    if (countersAvailable) {
+        std::printf("%18.2f\n", scattered.missesPerBlock);
+    } else {
+        std::printf("%18s\n", "n/a");
+    }
+    std::printf("%-10s%14.1f", "packed", packed.nanosecondsPerBlock);
+    if (countersAvailable) {
+        std::printf("%18.2f\n", packed.missesPerBlock);
+    } else {
+        std::printf("%18s\n", "n/a");
+        const char* error = scattered.counterError != nullptr ? scattered.counterError : packed.counterError;
+        std::printf("\nno L1D miss counts (%s), only the timing is meaningful\n", error);
+    }
+    return 0;
+}
@@ -0,0 +1,288 @@
+/*
+  ==============================================================================
+
+    DelayLineBenchmark.cpp
+    Created: 19 Oct 2026 12:21:54am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Measures DelayLine on its own: the per-sample write() / read() and the block versions that
+// run on the dispatched kernels, for
+//
+//   rings    "seam"  just over a block long, so every block's writes and reads wrap around
+//            "L1", "L2", "L3", "DRAM"  16 KB, 256 KB, 4 MB and 128 MB of samples, read around
+//            the middle so reads and writes stream through different parts of the ring
+//   delays   "integer" and "fractional" (constant), "modulated" (a sine of +-32 samples)
+//
+// Every case runs twice: writes alone, then writes followed by reads. The write columns come
+// from the first run, the read columns from the difference, so the loop and the input don't
+// count towards either. Each run covers the ring at least twice so it really works from the
+// level of the memory hierarchy it's named after.
+//
+// Cycles are core cycles from perf_event_open (Linux, when perf_event_paranoid allows it),
+// "-" elsewhere. GB/s counts the ring memory touched: 4 bytes per sample written or read.
+//
+//   BrocDelayDelayLineBenchmark [blockSize]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../Source/DelayLine.h"
+#include "../Source/DSPKernels.h"
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    // keeps the compiler from optimising the reads away
+    volatile float resultSink = 0.0f;
+
+    constexpr float modulationDepth = 32.0f;
+
+    // the modulated delays repeat after this many blocks
+    constexpr int modulationBlocks = 64;
+
+    // Counts user space CPU cycles of the calling thread
+    class CycleCounter
+    {
+    public:
+        CycleCounter()
+        {
+           #if defined(__linux__)
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+           #endif
+        }
+
+        ~CycleCounter()
+        {
+           #if defined(__linux__)
+            if (fd >= 0) {
+                close(fd);
+            }
+           #endif
+        }
+
+        bool isAvailable() const noexcept { return fd >= 0; }
+
+        void start() noexcept
+        {
+           #if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+           #endif
+        }
+
+        std::uint64_t stop() noexcept
+        {
+            std::uint64_t count = 0;
+           #if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                if (::read(fd, &count, sizeof(count)) != sizeof(count)) {
+                    count = 0;
+                }
+            }
+           #endif
+            return count;
+        }
+
+    private:
+        int fd = -1;
+    };
+
+    struct Ring
+    {
+        const char* name;
+        int length;  // in samples
+    };
+
+    enum class DelayKind { integer, fractional, modulated };
+
+    const char* getName(DelayKind kind)
+    {
+        switch (kind) {
+            case DelayKind::integer:    return "integer";
+            case DelayKind::fractional: return "fractional";
+            default:                    return "modulated";
+        }
+    }
+
+    // per sample
+    struct Measurement
+    {
+        double seconds = 0.0;
+        double cycles = 0.0;
+    };
+
+    struct Case
+    {
+        int ringLength;
+        float centre;  // the delay the reads are centred on
+        int blockSize;
+        DelayKind delayKind;
+        bool block;  // writeBlock() / readBlock() instead of write() / read()
+    };
+
+    // The delays of every sample of numBlocks blocks, as readBlock() wants them: relative to
+    // the end of the block, so sample i is at least i + 1 behind the write position. Made up
+    // front, so the timed loop only has to pick the block.
+    std::vector<float> makeDelays(const Case& c, int numBlocks)
+    {
+        std::vector<float> delays(size_t(numBlocks * c.blockSize));
+        for (int n = 0; n < numBlocks * c.blockSize; ++n) {
+            float delay = c.centre;
+            if (c.delayKind == DelayKind::fractional) {
+                delay += 0.37f;
+            } else if (c.delayKind == DelayKind::modulated) {
+                double phase = 2.0 * 3.141592653589793 * double(n) / double(numBlocks * c.blockSize);
+                delay += modulationDepth * float(std::sin(phase));
+            }
+            int i = n % c.blockSize;
+            delays[size_t(n)] = delay + float(c.blockSize - 1 - i) + 1.0f;
+        }
+        return delays;
+    }
+
+    Measurement run(const Case& c, bool withReads, CycleCounter& cycles)
+    {
+        DelayLine delayLine;
+        delayLine.setMaximumDelayInSamples(c.ringLength - 1);
+        delayLine.reset();
+
+        std::vector<float> input(size_t(c.blockSize));
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (auto& x : input) x = dist(rng);
+
+        int numDelayBlocks = c.delayKind == DelayKind::modulated ? modulationBlocks : 1;
+        auto delays = makeDelays(c, numDelayBlocks);
+        std::vector<float> output(size_t(c.blockSize));
+
+        // at least twice around the ring, and never less than a million samples
+        long long numSamples = std::max(2LL * c.ringLength, 1LL << 20);
+        long long numBlocks = (numSamples + c.blockSize - 1) / c.blockSize;
+
+        // one round untimed, so the whole ring has been touched once
+        for (long long b = 0; b < (c.ringLength + c.blockSize - 1) / c.blockSize; ++b) {
+            delayLine.writeBlock(input.data(), c.blockSize);
+        }
+
+        float sum = 0.0f;
+        cycles.start();
+        auto start = std::chrono::steady_clock::now();
+        for (long long b = 0; b < numBlocks; ++b) {
+            const float* blockDelays = delays.data() + size_t(b % numDelayBlocks) * size_t(c.blockSize);
+            if (c.block) {
+                delayLine.writeBlock(input.data(), c.blockSize);
+                if (withReads) {
+                    delayLine.readBlock(blockDelays, output.data(), c.blockSize);
+                    sum += output[0];
+                }
+            } else {
+                for (int i = 0; i < c.blockSize; ++i) {
+                    delayLine.write(input[size_t(i)]);
+                }
+                if (withReads) {
+                    // read() is relative to the last sample written, readBlock() to the one after
+                    for (int i = 0; i < c.blockSize; ++i) {
+                        output[size_t(i)] = delayLine.read(blockDelays[i] - 1.0f);
+                    }
+                    sum += output[0];
+                }
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        auto numCycles = cycles.stop();
+        resultSink = sum;
+
+        auto numProcessed = double(numBlocks * c.blockSize);
+        return { elapsed.count() / numProcessed, double(numCycles) / numProcessed };
+    }
+
+    void printColumns(double seconds, double cycles, bool haveCycles)
+    {
+        std::printf("%10.3f", seconds * 1e9);
+        if (haveCycles) {
+            std::printf("%10.2f", cycles);
+        } else {
+            std::printf("%10s", "-");
+        }
+        std::printf("%9.2f", seconds > 0.0 ? 4.0 / seconds * 1e-9 : 0.0);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int blockSize = argc > 1 ? std::atoi(argv[1]) : 256;
+    if (blockSize < 1) {
+        std::fprintf(stderr, "usage: %s [blockSize]\n", argv[0]);
+        return 2;
+    }
+
+    CycleCounter cycles;
+
+    // the seam ring is just long enough for the longest delay
+    int seamLength = blockSize + int(4 * modulationDepth) + 8;
+    const Ring rings[] = {
+        { "seam", seamLength },
+        { "L1",   (16 << 10) / int(sizeof(float)) },
+        { "L2",   (256 << 10) / int(sizeof(float)) },
+        { "L3",   (4 << 20) / int(sizeof(float)) },
+        { "DRAM", (128 << 20) / int(sizeof(float)) }
+    };
+
+    std::printf("kernels %s, block size %d%s\n\n", DSPKernels::get().name, blockSize,
+                cycles.isAvailable() ? "" : ", no cycle counter (perf_event_open not allowed)");
+    std::printf("%-6s%-12s%-8s%10s%10s%9s%10s%10s%9s\n", "ring", "delay", "api",
+                "write ns", "cycles", "GB/s", "read ns", "cycles", "GB/s");
+
+    for (const auto& ring : rings) {
+        // with very large blocks the small rings can't hold the delays
+        if (ring.length < seamLength) {
+            continue;
+        }
+        float centre = ring.length == seamLength
+            ? float(seamLength - blockSize) - 2.0f * modulationDepth - 2.0f
+            : float(ring.length / 2);
+
+        for (auto kind : { DelayKind::integer, DelayKind::fractional, DelayKind::modulated }) {
+            for (bool block : { false, true }) {
+                Case c { ring.length, centre, blockSize, kind, block };
+                auto writes = run(c, false, cycles);
+                auto both = run(c, true, cycles);
+
+                std::printf("%-6s%-12s%-8s", ring.name, getName(kind), block ? "block" : "sample");
+                printColumns(writes.seconds, writes.cycles, cycles.isAvailable());
+                printColumns(std::max(0.0, both.seconds - writes.seconds),
+                             std::max(0.0, both.cycles - writes.cycles), cycles.isAvailable());
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
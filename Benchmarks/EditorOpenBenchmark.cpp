@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    EditorOpenBenchmark.cpp
+    Created: 18 Oct 2026 9:02:44pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Times DelayAudioProcessor::createEditor(). The first editor in the process is the cold
+// open, it builds the shared resources (quotes, images, fonts, look-and-feels). The others
+// are opened and closed on their own processors while the first one stays open, the way
+// opening one more instance in a busy session works. Exits with 1 when the cold open or the
+// slowest warm open doesn't fit in a 60 Hz frame.
+//
+//   BrocDelayEditorOpenBenchmark [editors]
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "PluginProcessor.h"
+
+namespace
+{
+    constexpr double frameBudgetMs = 1000.0 / 60.0;
+
+    double openEditor(DelayAudioProcessor& processor, std::unique_ptr<juce::AudioProcessorEditor>& editor)
+    {
+        auto start = std::chrono::steady_clock::now();
+        editor.reset(processor.createEditor());
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int numEditors = argc > 1 ? std::atoi(argv[1]) : 32;
+    if (numEditors < 1) {
+        std::fprintf(stderr, "usage: %s [editors]\n", argv[0]);
+        return 2;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    DelayAudioProcessor firstProcessor;
+    std::unique_ptr<juce::AudioProcessorEditor> firstEditor;
+    double coldMs = openEditor(firstProcessor, firstEditor);
+
+    std::vector<double> warmMs;
+    for (int i = 0; i < numEditors; ++i) {
+        DelayAudioProcessor processor;
+        std::unique_ptr<juce::AudioProcessorEditor> editor;
+        warmMs.push_back(openEditor(processor, editor));
+    }
+    std::sort(warmMs.begin(), warmMs.end());
+
+    double medianMs = warmMs[warmMs.size() / 2];
+    double maxMs = warmMs.back();
+
+    std::printf("frame budget %.2f ms, %d warm editors\n\n", frameBudgetMs, numEditors);
+    std::printf("%-12s%10s\n", "open", "ms");
+    std::printf("%-12s%10.3f\n", "cold", coldMs);
+    std::printf("%-12s%10.3f\n", "warm median", medianMs);
+    std::printf("%-12s%10.3f\n", "warm max", maxMs);
+
+    bool withinBudget = coldMs <= frameBudgetMs && maxMs <= frameBudgetMs;
+    if (!withinBudget) {
+        std::printf("\nover the frame budget\n");
+    }
+
+    firstEditor.reset();
+    return withinBudget ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.cpp
+    Created: 18 Oct 2026 1:14:38pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Runs every DSPKernels variant this machine supports over the same data, checks that they
+// all produce the same output as the generic kernels and prints ns/sample for each one.
+//
+//   BrocDelayKernelBenchmark [blockSize] [iterations]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../Source/DSPKernels.h"
+
+using namespace DSPKernels;
+
+namespace
+{
+    struct TestData
+    {
+        explicit TestData(int blockSize) : size(blockSize)
+        {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> audio(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            auto fill = [&] (std::vector<float>& v, auto& dist) {
+                v.resize(size_t(size));
+                for (auto& x : v) x = dist(rng);
+            };
+
+            fill(dryL, audio); fill(dryR, audio);
+            fill(wetL, audio); fill(wetR, audio);
+            fill(amount, unit); fill(gains, unit);
+            fill(dryGain, unit); fill(wetGain, unit);
+            fill(mix, unit); fill(gain, unit);
+
+            // a 1 s delay line at 48 kHz, read around 250 ms with some wobble
+            bufferLength = 48001;
+            delayBuffer.resize(size_t(bufferLength));
+            for (auto& x : delayBuffer) x = audio(rng);
+            delays.resize(size_t(size));
+            for (int i = 0; i < size; ++i) {
+                delays[size_t(i)] = 12000.0f + 37.5f * std::sin(float(i) * 0.01f) + float(i % 3) * 0.25f;
+            }
+
+            lowCutG.assign(size_t(size), 0.0f);
+            lowCutH.assign(size_t(size), 0.0f);
+            highCutG.assign(size_t(size), 0.0f);
+            highCutH.assign(size_t(size), 0.0f);
+            float R2 = cutFilterR2();
+            for (int i = 0; i < size; ++i) {
+                cutFilterCoefficients(200.0f + float(i % 64), 48000.0, R2, lowCutG[size_t(i)], lowCutH[size_t(i)]);
+                cutFilterCoefficients(8000.0f - float(i % 64), 48000.0, R2, highCutG[size_t(i)], highCutH[size_t(i)]);
+            }
+            coeffs = { lowCutG.data(), lowCutH.data(), highCutG.data(), highCutH.data(), R2 };
+        }
+
+        int size;
+        int bufferLength;
+        std::vector<float> dryL, dryR, wetL, wetR, amount, gains, dryGain, wetGain, mix, gain;
+        std::vector<float> delayBuffer, delays;
+        std::vector<float> lowCutG, lowCutH, highCutG, highCutH;
+        CutFilterCoefficients coeffs;
+    };
+
+    struct Kernel
+    {
+        const char* name;
+        // sets up the output buffer; run() is what gets timed
+        std::function<void(const TestData&, std::vector<float>& out)> prepare;
+        std::function<void(const KernelTable&, const TestData&, std::vector<float>& out)> run;
+    };
+
+    void resizeOutput(const TestData& d, std::vector<float>& out) { out.assign(size_t(d.size) * 2, 0.0f); }
+
+    std::vector<Kernel> makeKernels()
+    {
+        return {
+            { "write", [] (const TestData& d, std::vector<float>& out) { out = d.delayBuffer; },
+              [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                int writeIndex = d.bufferLength - 100;  // force a wrap
+                k.write(out.data(), d.bufferLength, writeIndex, d.dryL.data(), d.size);
+            } },
+            { "read", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                k.read(d.delayBuffer.data(), d.bufferLength, 100, d.delays.data(), out.data(), d.size);
+            } },
+            { "crossfade", [] (const TestData& d, std::vector<float>& out) { out = d.wetL; },
+              [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                k.crossfade(out.data(), d.wetR.data(), d.amount.data(), d.size);
+            } },
+            { "multiply", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                k.multiply(d.wetL.data(), d.gains.data(), out.data(), d.size);
+            } },
+            { "add", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                k.add(d.dryL.data(), d.wetL.data(), out.data(), d.size);
+            } },
+            { "cutFilters", [] (const TestData& d, std::vector<float>& out) { out = d.wetL; },
+              [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                CutFilterState state;
+                k.cutFilters(out.data(), d.size, d.coeffs, state);
+            } },
+            { "feedbackInput", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                k.feedbackInput(d.dryL.data(), d.dryR.data(), d.wetL.data(), d.wetR.data(),
+                                d.amount.data(), out.data(), out.data() + d.size, d.size);
+            } },
+            { "mixGain", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                k.mixGain(d.dryL.data(), d.wetL.data(), d.dryGain.data(), d.wetGain.data(),
+                          d.mix.data(), d.gain.data(), out.data(), d.size);
+            } },
+            { "peak", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                out[0] = k.peak(d.wetL.data(), d.size);
+            } },
+            { "sumOfSquares", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                double sum = k.sumOfSquares(d.wetL.data(), d.size);
+                std::memcpy(out.data(), &sum, sizeof(sum));
+            } },
+            { "truePeak", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                // the block is read with the samples before it as history
+                out[0] = k.truePeak(d.wetL.data() + truePeakHistory, d.size - truePeakHistory);
+            } },
+            { "minMax", resizeOutput, [] (const KernelTable& k, const TestData& d, std::vector<float>& out) {
+                out[0] = std::numeric_limits<float>::infinity();
+                out[1] = -std::numeric_limits<float>::infinity();
+                k.minMax(d.wetL.data(), d.size, out[0], out[1]);
+            } },
+        };
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int blockSize = argc > 1 ? std::atoi(argv[1]) : 512;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20000;
+    if (blockSize <= 0 || iterations <= 0) {
+        std::fprintf(stderr, "usage: %s [blockSize] [iterations]\n", argv[0]);
+        return 2;
+    }
+
+    TestData data(blockSize);
+    auto kernels = makeKernels();
+
+    std::printf("selected: %s, best supported: %s\n", get().name, getName(detectBestISA()));
+    std::printf("block size %d, %d iterations, ns/sample\n\n", blockSize, iterations);
+
+    std::printf("%-14s", "kernel");
+    std::vector<const KernelTable*> tables;
+    for (auto isa : { ISA::GENERIC, ISA::SSE2, ISA::AVX2, ISA::AVX512 }) {
+        if (auto* table = getTable(isa)) {
+            tables.push_back(table);
+            std::printf("%10s", table->name);
+        }
+    }
+    std::printf("\n");
+
+    bool mismatch = false;
+    for (const auto& kernel : kernels) {
+        std::printf("%-14s", kernel.name);
+
+        std::vector<float> reference;
+        kernel.prepare(data, reference);
+        kernel.run(*tables.front(), data, reference);
+
+        for (auto* table : tables) {
+            std::vector<float> out;
+            kernel.prepare(data, out);
+            kernel.run(*table, data, out);
+            bool same = out.size() == reference.size()
+                     && std::memcmp(out.data(), reference.data(), out.size() * sizeof(float)) == 0;
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                kernel.run(*table, data, out);
+            }
+            auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+            std::printf("%9.3f%c", elapsed.count() / (double(iterations) * blockSize), same ? ' ' : '!');
+            mismatch |= !same;
+        }
+        std::printf("\n");
+    }
+
+    if (mismatch) {
+        std::printf("\n! output differs from the generic kernel\n");
+        return 1;
+    }
+    return 0;
+}
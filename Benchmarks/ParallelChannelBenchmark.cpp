@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    ParallelChannelBenchmark.cpp
+    Created: 18 Oct 2026 2:58:10pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Renders two independent delay channels (read, cut filters, feedback, write, the same kernel
+// calls processDelayChannel() makes) once one after the other and once on a WorkerPool, for a
+// range of block sizes. The smallest block size from which the pool keeps winning is what
+// DelayEngine::parallelBlockSizeThreshold should be, build with it as
+// -DBROCDELAY_PARALLEL_BLOCK_SIZE=n.
+//
+//   BrocDelayParallelChannelBenchmark [totalSamples]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../Source/DSPKernels.h"
+#include "../Source/WorkerPool.h"
+
+using namespace DSPKernels;
+
+namespace
+{
+    constexpr int bufferLength = 96001;  // 2 s at 48 kHz
+    constexpr float delay = 24000.0f;
+
+    struct Channel
+    {
+        explicit Channel(int maxBlockSize)
+            : buffer(size_t(bufferLength), 0.0f), wet(size_t(maxBlockSize)),
+              feedbackOut(size_t(maxBlockSize) + 1), delayInput(size_t(maxBlockSize)) {}
+
+        std::vector<float> buffer;
+        int writeIndex = bufferLength - 1;
+        CutFilterState filterState;
+        float feedback = 0.0f;
+        std::vector<float> wet, feedbackOut, delayInput;
+    };
+
+    struct Controls
+    {
+        explicit Controls(int maxBlockSize)
+        {
+            auto size = size_t(maxBlockSize);
+            dry.resize(size);
+            for (size_t i = 0; i < size; ++i) {
+                dry[i] = std::sin(float(i) * 0.05f);
+            }
+            delays.assign(size, delay);
+            feedbacks.assign(size, 0.5f);
+
+            float R2 = cutFilterR2();
+            float g, h;
+            cutFilterCoefficients(200.0f, 48000.0, R2, g, h);
+            lowCutG.assign(size, g);
+            lowCutH.assign(size, h);
+            cutFilterCoefficients(8000.0f, 48000.0, R2, g, h);
+            highCutG.assign(size, g);
+            highCutH.assign(size, h);
+            coeffs = { lowCutG.data(), lowCutH.data(), highCutG.data(), highCutH.data(), R2 };
+        }
+
+        std::vector<float> dry, delays, feedbacks, lowCutG, lowCutH, highCutG, highCutH;
+        CutFilterCoefficients coeffs;
+    };
+
+    void processChannel(const KernelTable& k, const Controls& c, Channel& ch, int numSamples) noexcept
+    {
+        // the delay is much longer than any block, so one chunk is enough
+        k.read(ch.buffer.data(), bufferLength, ch.writeIndex, c.delays.data(), ch.wet.data(), numSamples);
+        k.cutFilters(ch.wet.data(), numSamples, c.coeffs, ch.filterState);
+        ch.feedbackOut[0] = ch.feedback;
+        k.multiply(ch.wet.data(), c.feedbacks.data(), ch.feedbackOut.data() + 1, numSamples);
+        ch.feedback = ch.feedbackOut[size_t(numSamples)];
+        k.add(c.dry.data(), ch.feedbackOut.data(), ch.delayInput.data(), numSamples);
+        k.write(ch.buffer.data(), bufferLength, ch.writeIndex, ch.delayInput.data(), numSamples);
+    }
+
+    template <typename Render>
+    double nanosecondsPerSample(int totalSamples, Render&& render)
+    {
+        render();  // warm up
+        auto start = std::chrono::steady_clock::now();
+        render();
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / double(totalSamples);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int totalSamples = argc > 1 ? std::atoi(argv[1]) : 48000 * 60;
+    if (totalSamples <= 0) {
+        std::fprintf(stderr, "usage: %s [totalSamples]\n", argv[0]);
+        return 2;
+    }
+
+    const auto& kernels = get();
+    WorkerPool pool;
+    pool.start(1);
+
+    std::printf("kernels: %s, hardware threads: %u\n", kernels.name, std::thread::hardware_concurrency());
+    std::printf("%d samples per channel, ns/sample\n\n", totalSamples);
+    std::printf("%-8s%10s%10s%10s\n", "block", "serial", "parallel", "speedup");
+
+    int crossover = 0;
+    for (int blockSize = 64; blockSize <= 16384; blockSize *= 2) {
+        Controls controls(blockSize);
+        Channel left(blockSize), right(blockSize);
+        int numBlocks = std::max(1, totalSamples / blockSize);
+
+        double serial = nanosecondsPerSample(numBlocks * blockSize, [&] {
+            for (int b = 0; b < numBlocks; ++b) {
+                processChannel(kernels, controls, left, blockSize);
+                processChannel(kernels, controls, right, blockSize);
+            }
+        });
+
+        double parallel = nanosecondsPerSample(numBlocks * blockSize, [&] {
+            for (int b = 0; b < numBlocks; ++b) {
+                auto task = [&] (int channel) {
+                    processChannel(kernels, controls, channel == 0 ? left : right, blockSize);
+                };
+                pool.run(2, task);
+            }
+        });
+
+        double speedup = serial / parallel;
+        std::printf("%-8d%10.3f%10.3f%9.2fx\n", blockSize, serial, parallel, speedup);
+        // only counts if it keeps winning for all larger blocks too
+        if (speedup <= 1.0) {
+            crossover = 0;
+        } else if (crossover == 0) {
+            crossover = blockSize;
+        }
+    }
+
+    if (crossover > 0) {
+        std::printf("\nparallel wins from %d samples, build with -DBROCDELAY_PARALLEL_BLOCK_SIZE=%d\n",
+                    crossover, crossover);
+    } else {
+        std::printf("\nparallel never wins on this machine\n");
+    }
+    return 0;
+}
@@ -0,0 +1,425 @@
+/*
+  ==============================================================================
+
+    ProcessBlockBenchmark.cpp
+    Created: 18 Oct 2026 11:58:31pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Runs DelayAudioProcessor without an editor or a host and measures what processBlock costs.
+// Every configuration gets a fresh processor, a quarter second of warm-up and then the
+// requested amount of audio (noise at -12 dBFS), timed block by block.
+//
+// By default one setting is varied at a time around 48 kHz, 256 samples, stereo, repitch,
+// no tempo sync, no flip flop, no automation and a steady transport. --full runs every
+// combination instead. --transport takes the names below or ScriptedPlayHead scripts:
+//
+//   steady  playing at 120 bpm        ramps  tempo up and down between 80 and 160 bpm
+//   loop    a half second loop        seeks  the transport jumps twice a second
+//   stops   stopped for a tenth of every second
+//
+// --replay plays back an automation log instead (see AutomationLog.h): one run, at the log's
+// sample rate, with its blocks and parameter changes, in the layout and transport of the
+// base configuration and without warm-up. Its blockSize column is the largest block.
+//
+// Prints one CSV row per configuration:
+//
+//   nsPerSample       processing time per sample frame
+//   realtimeFactor    seconds of audio rendered per second of processing
+//   instancesPerCore  how many instances one core fits when every block has to be done
+//                     in time, from the 99th percentile block (so below realtimeFactor)
+//
+// Set BROCDELAY_ISA to compare the kernel variants, the column "isa" says which one ran.
+// Built with BROCDELAY_REALTIME_CHECK, any allocation or lock in processBlock is printed to
+// stderr with the configuration it happened in, and the run exits with 1.
+//
+//   BrocDelayProcessBlockBenchmark [--full] [--seconds s] [--rates 44100,...] [--blocks 64,...]
+//       [--layouts mono,mono-stereo,stereo] [--modes repitch,fade,duck] [--sync off,on]
+//       [--flipflop off,on] [--automation static,jumps,sweep]
+//       [--transport steady,ramps,loop,seeks,stops,"script",...] [--replay log]
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "PluginProcessor.h"
+#include "RealtimeCheck.h"
+#include "AutomationLog.h"
+#include "ScriptedPlayHead.h"
+
+namespace
+{
+    int numRealtimeViolations = 0;
+
+    struct Config
+    {
+        double sampleRate;
+        int blockSize;
+        juce::String layout;
+        juce::String mode;
+        juce::String sync;
+        juce::String flipFlop;
+        juce::String automation;
+        juce::String transport;
+    };
+
+    struct Options
+    {
+        juce::StringArray rates { "44100", "48000", "88200", "96000", "176400", "192000" };
+        juce::StringArray blocks { "1", "16", "64", "256", "1024", "8192" };
+        juce::StringArray layouts { "mono", "mono-stereo", "stereo" };
+        juce::StringArray modes { "repitch", "fade", "duck" };
+        juce::StringArray sync { "off", "on" };
+        juce::StringArray flipFlop { "off", "on" };
+        juce::StringArray automation { "static", "jumps", "sweep" };
+        juce::StringArray transport { "steady", "ramps", "loop", "seeks", "stops" };
+        double seconds = 2.0;
+        bool full = false;
+        juce::String replay;
+    };
+
+    juce::String getTransportScript(const juce::String& name)
+    {
+        if (name == "steady") return "";
+        if (name == "ramps")  return "0 ramp 160 1; 1 ramp 80 1; repeat 2";
+        if (name == "loop")   return "0 loop 0 0.5";
+        if (name == "seeks")  return "0.25 seek 3; 0.75 seek 1; repeat 1";
+        if (name == "stops")  return "0.5 stop; 0.6 play; repeat 1";
+        return name;
+    }
+
+    juce::AudioProcessor::BusesLayout getLayout(const juce::String& name)
+    {
+        juce::AudioProcessor::BusesLayout layout;
+        auto mono = juce::AudioChannelSet::mono();
+        auto stereo = juce::AudioChannelSet::stereo();
+        layout.inputBuses.add(name == "stereo" ? stereo : mono);
+        layout.outputBuses.add(name == "mono" ? mono : stereo);
+        return layout;
+    }
+
+    void setParameter(DelayAudioProcessor& processor, const juce::ParameterID& id, float value)
+    {
+        auto* param = processor.apvts.getParameter(id.getParamID());
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    // Moves the parameters the way the automation pattern says, for the block starting at time
+    void automate(DelayAudioProcessor& processor, const Config& config, double time)
+    {
+        bool sync = config.sync == "on";
+        if (config.automation == "jumps") {
+            // a new delay every quarter second, which is where the shift modes kick in
+            bool second = int(time * 4.0) % 2 == 1;
+            if (sync) {
+                setParameter(processor, ParamIDs::delayNote, second ? 9.0f : 6.0f);
+            } else {
+                setParameter(processor, ParamIDs::delayTime, second ? 400.0f : 250.0f);
+            }
+        } else if (config.automation == "sweep") {
+            // everything smoothed moves all the time
+            float lfo = float(std::sin(2.0 * juce::MathConstants<double>::pi * 0.5 * time));
+            if (sync) {
+                setParameter(processor, ParamIDs::delayNote, float(6 + int(time * 10.0) % 4));
+            } else {
+                setParameter(processor, ParamIDs::delayTime, 300.0f + 100.0f * lfo);
+            }
+            setParameter(processor, ParamIDs::mix, 50.0f + 25.0f * lfo);
+            setParameter(processor, ParamIDs::feedback, 50.0f - 25.0f * lfo);
+            setParameter(processor, ParamIDs::lowCut, 200.0f + 150.0f * lfo);
+            setParameter(processor, ParamIDs::highCut, 8000.0f - 4000.0f * lfo);
+        }
+    }
+
+    // The log's parameters in this build, nullptr for the ones it doesn't have (any more)
+    std::vector<juce::RangedAudioParameter*> getLogParameters(DelayAudioProcessor& processor,
+                                                              const AutomationLog::Log& log)
+    {
+        std::vector<juce::RangedAudioParameter*> parameters;
+        for (const auto& id : log.parameterIDs) {
+            auto* param = processor.apvts.getParameter(juce::String(id));
+            if (param == nullptr) {
+                std::fprintf(stderr, "the log has a parameter %s, which isn't there, ignoring it\n", id.c_str());
+            }
+            parameters.push_back(param);
+        }
+        return parameters;
+    }
+
+    // Without a log: a warm-up and then seconds of audio in blocks of config.blockSize.
+    // With one: the log's blocks and parameter changes, all of them timed.
+    void run(const Config& config, double seconds, const AutomationLog::Log* log = nullptr)
+    {
+        DelayAudioProcessor processor;
+        if (!processor.setBusesLayout(getLayout(config.layout))) {
+            std::fprintf(stderr, "layout %s not supported\n", config.layout.toRawUTF8());
+            return;
+        }
+
+        ScriptedPlayHead playHead(config.sampleRate);
+        auto scriptResult = playHead.setScript(getTransportScript(config.transport));
+        if (scriptResult.failed()) {
+            std::fprintf(stderr, "%s\n", scriptResult.getErrorMessage().toRawUTF8());
+            return;
+        }
+        processor.setPlayHead(&playHead);
+        processor.setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+
+        int mode = config.mode == "fade" ? 1 : config.mode == "duck" ? 2 : 0;
+        setParameter(processor, ParamIDs::accelerateMode, float(mode));
+        setParameter(processor, ParamIDs::decelerateMode, float(mode));
+        setParameter(processor, ParamIDs::tempoSync, config.sync == "on" ? 1.0f : 0.0f);
+        setParameter(processor, ParamIDs::flipFlop, config.flipFlop == "on" ? 1.0f : 0.0f);
+        setParameter(processor, ParamIDs::feedback, 50.0f);
+
+        processor.prepareToPlay(config.sampleRate, config.blockSize);
+
+        int numChannels = std::max(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        juce::AudioBuffer<float> buffer(numChannels, config.blockSize);
+        juce::MidiBuffer midi;
+
+        // a second of noise, cycled through so the input doesn't cost anything in the loop
+        int noiseLength = int(config.sampleRate);
+        juce::AudioBuffer<float> noise(numChannels, noiseLength + config.blockSize);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-0.25f, 0.25f);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            for (int i = 0; i < noise.getNumSamples(); ++i) {
+                noise.setSample(channel, i, dist(rng));
+            }
+        }
+
+        auto numWarmupBlocks = log != nullptr ? 0 : int(std::ceil(0.25 * config.sampleRate / config.blockSize));
+        auto numBlocks = std::max(1, int(std::ceil(seconds * config.sampleRate / config.blockSize)));
+
+        std::vector<juce::RangedAudioParameter*> logParameters;
+        size_t nextEvent = 0;
+        int logBlockSize = config.blockSize;
+        if (log != nullptr) {
+            logParameters = getLogParameters(processor, *log);
+        }
+
+        // each block's time as a share of its real-time budget
+        std::vector<double> loads;
+        loads.reserve(size_t(numBlocks));
+        double totalNs = 0.0;
+        int64_t numTimedSamples = 0;
+
+        int noisePosition = 0;
+        int64_t position = 0;
+        for (int block = 0;; ++block) {
+            int size = config.blockSize;
+            if (log != nullptr) {
+                if (position >= log->length) {
+                    break;
+                }
+                for (; nextEvent < log->events.size() && log->events[nextEvent].samplePosition <= position; ++nextEvent) {
+                    const auto& event = log->events[nextEvent];
+                    if (event.parameter == AutomationLog::blockSizeChange) {
+                        logBlockSize = int(event.value);
+                    } else if (auto* param = logParameters[size_t(event.parameter)]) {
+                        param->setValueNotifyingHost(event.value);
+                    }
+                }
+                size = int(std::min(int64_t(logBlockSize), log->length - position));
+            } else {
+                if (block >= numWarmupBlocks + numBlocks) {
+                    break;
+                }
+                automate(processor, config, double(position) / config.sampleRate);
+            }
+
+            juce::AudioBuffer<float> view(buffer.getArrayOfWritePointers(), numChannels, size);
+            for (int channel = 0; channel < numChannels; ++channel) {
+                view.copyFrom(channel, 0, noise, channel, noisePosition, size);
+            }
+            noisePosition = (noisePosition + size) % noiseLength;
+
+            auto start = std::chrono::steady_clock::now();
+            processor.processBlock(view, midi);
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+            if (block >= numWarmupBlocks) {
+                loads.push_back(elapsed.count() / (1e9 * size / config.sampleRate));
+                totalNs += elapsed.count();
+                numTimedSamples += size;
+            }
+            playHead.advance(size);
+            position += size;
+        }
+
+        processor.releaseResources();
+
+       #if BROCDELAY_REALTIME_CHECK
+        auto title = juce::String(config.sampleRate, 0) + "," + juce::String(config.blockSize) + "," + config.layout
+                   + "," + config.mode + "," + config.sync + "," + config.flipFlop + "," + config.automation
+                   + "," + config.transport;
+        numRealtimeViolations += RealtimeCheck::report(stderr, title.toRawUTF8());
+       #endif
+
+        if (loads.empty()) {
+            return;
+        }
+        std::sort(loads.begin(), loads.end());
+        double p99Load = loads[std::min(loads.size() - 1, size_t(0.99 * double(loads.size())))];
+
+        double nsPerSample = totalNs / double(numTimedSamples);
+        double realtimeFactor = 1e9 * double(numTimedSamples) / config.sampleRate / totalNs;
+        double instancesPerCore = 1.0 / p99Load;
+
+        std::printf("%.0f,%d,%s,%s,%s,%s,%s,%s,%s,%.3f,%.2f,%.2f\n",
+                    config.sampleRate, config.blockSize, config.layout.toRawUTF8(), config.mode.toRawUTF8(),
+                    config.sync.toRawUTF8(), config.flipFlop.toRawUTF8(), config.automation.toRawUTF8(),
+                    config.transport.toRawUTF8(), DSPKernels::get().name, nsPerSample, realtimeFactor, instancesPerCore);
+        std::fflush(stdout);
+    }
+
+    Config makeConfig(const juce::StringArray& values)
+    {
+        return { values[0].getDoubleValue(), values[1].getIntValue(), values[2], values[3], values[4], values[5], values[6],
+                 values[7] };
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            juce::String arg(argv[i]);
+            if (arg == "--full") {
+                options.full = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            juce::String value(argv[++i]);
+            auto list = juce::StringArray::fromTokens(value, ",", "");
+
+            if (arg == "--seconds")         options.seconds = value.getDoubleValue();
+            else if (arg == "--rates")      options.rates = list;
+            else if (arg == "--blocks")     options.blocks = list;
+            else if (arg == "--layouts")    options.layouts = list;
+            else if (arg == "--modes")      options.modes = list;
+            else if (arg == "--sync")       options.sync = list;
+            else if (arg == "--flipflop")   options.flipFlop = list;
+            else if (arg == "--automation") options.automation = list;
+            else if (arg == "--transport")  options.transport = list;
+            else if (arg == "--replay")     options.replay = value;
+            else return false;
+        }
+
+        for (auto& block : options.blocks) {
+            if (block.getIntValue() < 1) {
+                return false;
+            }
+        }
+        return options.seconds > 0.0;
+    }
+
+    int getExitCode()
+    {
+        if (numRealtimeViolations > 0) {
+            std::fprintf(stderr, "\n%d real-time violations in processBlock\n", numRealtimeViolations);
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--full] [--seconds s] [--rates 44100,...] [--blocks 64,...]\n"
+                             "    [--layouts mono,mono-stereo,stereo] [--modes repitch,fade,duck] [--sync off,on]\n"
+                             "    [--flipflop off,on] [--automation static,jumps,sweep]\n"
+                             "    [--transport steady,ramps,loop,seeks,stops,\"script\",...] [--replay log]\n", argv[0]);
+        return 2;
+    }
+
+    AutomationLog::Log log;
+    if (options.replay.isNotEmpty()) {
+        auto error = AutomationLog::read(options.replay.toRawUTF8(), log);
+        if (!error.empty() || log.length == 0) {
+            std::fprintf(stderr, "%s\n", error.empty() ? "the automation log is empty" : error.c_str());
+            return 2;
+        }
+        if (log.numDropped > 0) {
+            std::fprintf(stderr, "the automation log misses %llu changes, the plugin couldn't write them fast enough\n",
+                         (unsigned long long) log.numDropped);
+        }
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::vector<juce::StringArray> dimensions {
+        options.rates, options.blocks, options.layouts, options.modes, options.sync, options.flipFlop, options.automation,
+        options.transport
+    };
+
+    std::printf("sampleRate,blockSize,layout,shiftMode,tempoSync,flipFlop,automation,transport,isa,"
+                "nsPerSample,realtimeFactor,instancesPerCore\n");
+
+    juce::StringArray base { "48000", "256", "stereo", "repitch", "off", "off", "static", "steady" };
+    for (size_t d = 0; d < dimensions.size(); ++d) {
+        if (!dimensions[d].contains(base[int(d)])) {
+            base.set(int(d), dimensions[d][0]);
+        }
+    }
+
+    if (options.replay.isNotEmpty()) {
+        auto config = makeConfig(base);
+        config.sampleRate = log.sampleRate;
+        config.blockSize = 1;
+        for (const auto& event : log.events) {
+            if (event.parameter == AutomationLog::blockSizeChange) {
+                config.blockSize = std::max(config.blockSize, int(event.value));
+            }
+        }
+        config.automation = "replay";
+        run(config, 0.0, &log);
+        return getExitCode();
+    }
+
+    if (options.full) {
+        // every combination, counting through the dimensions like an odometer
+        std::vector<int> index(dimensions.size(), 0);
+        for (;;) {
+            juce::StringArray values;
+            for (size_t d = 0; d < dimensions.size(); ++d) {
+                values.add(dimensions[d][index[d]]);
+            }
+            run(makeConfig(values), options.seconds);
+
+            size_t d = dimensions.size();
+            while (d > 0 && ++index[d - 1] == dimensions[d - 1].size()) {
+                index[d - 1] = 0;
+                --d;
+            }
+            if (d == 0) {
+                break;
+            }
+        }
+        return getExitCode();
+    }
+
+    // the base configuration, then each dimension on its own
+    run(makeConfig(base), options.seconds);
+
+    for (size_t d = 0; d < dimensions.size(); ++d) {
+        for (auto& value : dimensions[d]) {
+            if (value != base[int(d)]) {
+                auto values = base;
+                values.set(int(d), value);
+                run(makeConfig(values), options.seconds);
+            }
+        }
+    }
+    return getExitCode();
+}
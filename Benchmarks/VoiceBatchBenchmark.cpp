@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    VoiceBatchBenchmark.cpp
+    Created: 19 Oct 2026 5:08:43am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Renders the same mono voices once with a DelayEngine per voice and once as a DelayVoiceBatch
+// with every kernel variant this machine supports, and prints ns per voice and sample for each.
+// The batch has to produce the same output with every variant.
+//
+// It does so twice: with parameters that stay put, where most control blocks of the batch take
+// the steady path and the output stays within rounding of the engines, and with delay time
+// and high cut set again before every block, as a synth modulating its voices would. There
+// the two drift apart: both glide the delay with a one-pole that, in float, stops a couple of
+// samples short of where it's heading, the engine's in milliseconds and the batch's in
+// samples, so they stop at different places.
+//
+//   BrocDelayVoiceBatchBenchmark [numVoices] [seconds]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "../Source/DelayEngine.h"
+#include "../Source/DelayVoiceBatch.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    // every voice gets its own delay time and a few bursts of a sine of its own
+    float getDelayTime(int voice)
+    {
+        return 100.0f + float(voice % 13) * 23.0f;
+    }
+
+    void setParameters(int voice, auto&& set)
+    {
+        set(DelayEngine::delayTime, getDelayTime(voice));
+        set(DelayEngine::feedback, 40.0f + float(voice % 5) * 10.0f);
+        set(DelayEngine::mix, 50.0f);
+        set(DelayEngine::lowCut, 120.0f);
+        set(DelayEngine::highCut, 6000.0f + float(voice % 7) * 1000.0f);
+        set(DelayEngine::gain, -3.0f);
+    }
+
+    // the modulated run: a slow vibrato on the delay time and a sweep of the high cut, each
+    // voice at its own phase
+    void modulateParameters(int voice, int block, auto&& set)
+    {
+        float phase = float(block * blockSize) / float(sampleRate) + float(voice) * 0.37f;
+        set(DelayEngine::delayTime, getDelayTime(voice) + 5.0f * std::sin(6.2831853f * 0.5f * phase));
+        set(DelayEngine::highCut, 8000.0f + 4000.0f * std::sin(6.2831853f * 0.2f * phase));
+    }
+
+    float getInput(int voice, int sample)
+    {
+        bool on = sample % 24000 < 2400;
+        return on ? 0.5f * std::sin(float(sample) * (0.01f + float(voice % 11) * 0.003f)) : 0.0f;
+    }
+
+    template <typename Render>
+    double nanosecondsPerSample(long long totalSamples, Render&& render)
+    {
+        auto start = std::chrono::steady_clock::now();
+        render();
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / double(totalSamples);
+    }
+
+    // Renders the input with the engines and with the batch on every kernel variant. Returns
+    // false when a variant's output differs from the generic kernel's.
+    bool runCase(const char* title, bool modulated, int numVoices, int numBlocks,
+                 const std::vector<float>& input)
+    {
+        const int numSamples = numBlocks * blockSize;
+        const long long voiceSamples = (long long) numVoices * numSamples;
+
+        std::printf("%s\n", title);
+
+        // one engine per voice, each rendering its voice as mono
+        std::vector<float> engineOutput(size_t(numVoices) * size_t(numSamples));
+        {
+            std::vector<std::unique_ptr<DelayEngine>> engines;
+            for (int v = 0; v < numVoices; ++v) {
+                auto engine = std::make_unique<DelayEngine>();
+                setParameters(v, [&] (int parameter, float value) { engine->setParameter(parameter, value); });
+                engine->prepare(sampleRate, blockSize);
+                engines.push_back(std::move(engine));
+            }
+
+            std::vector<float> voiceInput((size_t) numSamples);
+            std::vector<float> voiceOutput((size_t) numSamples);
+            double total = 0.0;
+            for (int v = 0; v < numVoices; ++v) {
+                for (int i = 0; i < numSamples; ++i) {
+                    voiceInput[size_t(i)] = getInput(v, i);
+                }
+                auto& engine = *engines[size_t(v)];
+                total += nanosecondsPerSample(voiceSamples, [&] {
+                    for (int b = 0; b < numBlocks; ++b) {
+                        if (modulated) {
+                            modulateParameters(v, b, [&] (int parameter, float value) { engine.setParameter(parameter, value); });
+                        }
+                        size_t offset = size_t(b) * blockSize;
+                        engine.process(voiceInput.data() + offset, voiceInput.data() + offset,
+                                       voiceOutput.data() + offset, voiceOutput.data() + offset, blockSize);
+                    }
+                });
+                for (int i = 0; i < numSamples; ++i) {
+                    engineOutput[size_t(i) * size_t(numVoices) + size_t(v)] = voiceOutput[size_t(i)];
+                }
+            }
+            std::printf("%-14s%9.3f\n", "engines", total);
+        }
+
+        std::vector<float> reference;
+        bool mismatch = false;
+        for (auto isa : { DSPKernels::ISA::GENERIC, DSPKernels::ISA::SSE2, DSPKernels::ISA::AVX2,
+                          DSPKernels::ISA::AVX512 }) {
+            if (!DSPKernels::setOverride(isa)) {
+                continue;
+            }
+
+            DelayVoiceBatch batch(numVoices);
+            for (int v = 0; v < numVoices; ++v) {
+                setParameters(v, [&] (int parameter, float value) { batch.setParameter(v, parameter, value); });
+            }
+            batch.prepare(sampleRate);
+
+            std::vector<float> output(input.size());
+            double time = nanosecondsPerSample(voiceSamples, [&] {
+                for (int b = 0; b < numBlocks; ++b) {
+                    if (modulated) {
+                        for (int v = 0; v < numVoices; ++v) {
+                            modulateParameters(v, b, [&] (int parameter, float value) { batch.setParameter(v, parameter, value); });
+                        }
+                    }
+                    size_t offset = size_t(b) * blockSize * size_t(numVoices);
+                    batch.process(input.data() + offset, output.data() + offset, blockSize);
+                }
+            });
+
+            if (reference.empty()) {
+                reference = output;
+            }
+            bool same = std::memcmp(output.data(), reference.data(), output.size() * sizeof(float)) == 0;
+            mismatch |= !same;
+
+            float difference = 0.0f;
+            for (size_t i = 0; i < output.size(); ++i) {
+                difference = std::max(difference, std::abs(output[i] - engineOutput[i]));
+            }
+
+            std::printf("%-14s%9.3f%c   %.1e from the engines\n", DSPKernels::getName(isa), time,
+                        same ? ' ' : '!', double(difference));
+        }
+        DSPKernels::clearOverride();
+
+        if (mismatch) {
+            std::printf("! output differs from the generic kernel\n");
+        }
+        return !mismatch;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int requestedVoices = argc > 1 ? std::atoi(argv[1]) : 64;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 10.0;
+    if (requestedVoices <= 0 || !(seconds > 0.0)) {
+        std::fprintf(stderr, "usage: %s [numVoices] [seconds]\n", argv[0]);
+        return 2;
+    }
+
+    DelayVoiceBatch probe(requestedVoices);
+    const int numVoices = probe.getNumVoices();
+    const int numBlocks = std::max(1, int(seconds * sampleRate) / blockSize);
+    const int numSamples = numBlocks * blockSize;
+
+    // frame by frame, the batch's layout
+    std::vector<float> input(size_t(numVoices) * size_t(numSamples));
+    for (int i = 0; i < numSamples; ++i) {
+        for (int v = 0; v < numVoices; ++v) {
+            input[size_t(i) * size_t(numVoices) + size_t(v)] = getInput(v, i);
+        }
+    }
+
+    std::printf("%d voices, %d samples each, ns per voice and sample\n\n", numVoices, numSamples);
+
+    bool ok = runCase("fixed parameters", false, numVoices, numBlocks, input);
+    std::printf("\n");
+    ok &= runCase("delay time and high cut set every block", true, numVoices, numBlocks, input);
+    return ok ? 0 : 1;
+}
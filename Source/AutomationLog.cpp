@@ -0,0 +1,323 @@
+/*
+  ==============================================================================
+
+    AutomationLog.cpp
+    Created: 19 Oct 2026 2:08:45am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include "AutomationLog.h"
+
+namespace AutomationLog
+{
+
+namespace
+{
+    constexpr char magic[4] = { 'B', 'D', 'A', 'L' };
+    constexpr uint32_t version = 1;
+
+    enum RecordKind : uint8_t { endRecord = 0, blockSizeRecord = 1, firstParameterRecord = 2 };
+
+    constexpr int maxParameters = 255 - firstParameterRecord;
+
+    // one log per process
+    std::atomic<bool> anyRecording { false };
+
+    // Reads what the writer wrote, all of it little endian
+    class Reader
+    {
+    public:
+        explicit Reader(std::FILE* file_) : file(file_) {}
+
+        bool readBytes(void* dest, size_t size)
+        {
+            return std::fread(dest, 1, size, file) == size;
+        }
+
+        bool readU8(uint8_t& value)
+        {
+            return readBytes(&value, 1);
+        }
+
+        bool readU32(uint32_t& value)
+        {
+            uint8_t bytes[4];
+            if (!readBytes(bytes, 4)) {
+                return false;
+            }
+            value = uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+            return true;
+        }
+
+        bool readF32(float& value)
+        {
+            uint32_t bits;
+            if (!readU32(bits)) {
+                return false;
+            }
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+
+        bool readF64(double& value)
+        {
+            uint32_t low, high;
+            if (!readU32(low) || !readU32(high)) {
+                return false;
+            }
+            uint64_t bits = uint64_t(low) | uint64_t(high) << 32;
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+
+        bool readVarint(uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte;
+                if (!readU8(byte)) {
+                    return false;
+                }
+                value |= uint64_t(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        std::FILE* file;
+    };
+
+    void writeU32(std::FILE* file, uint32_t value)
+    {
+        uint8_t bytes[4] = { uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24) };
+        std::fwrite(bytes, 1, 4, file);
+    }
+}
+
+std::string read(const char* path, Log& log)
+{
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        return "can't open " + std::string(path);
+    }
+    Reader reader(file);
+    log = {};
+
+    auto fail = [file] (const std::string& message) {
+        std::fclose(file);
+        return message;
+    };
+
+    char fileMagic[4];
+    uint32_t fileVersion = 0;
+    uint32_t numParameters = 0;
+    if (!reader.readBytes(fileMagic, 4) || std::memcmp(fileMagic, magic, 4) != 0) {
+        return fail(std::string(path) + " isn't an automation log");
+    }
+    if (!reader.readU32(fileVersion) || fileVersion != version) {
+        return fail(std::string(path) + " is an automation log of another version");
+    }
+    if (!reader.readF64(log.sampleRate) || !(log.sampleRate > 0.0) || !reader.readU32(numParameters)
+            || numParameters > uint32_t(maxParameters)) {
+        return fail(std::string(path) + " has a broken header");
+    }
+    for (uint32_t i = 0; i < numParameters; ++i) {
+        uint8_t length;
+        std::string id;
+        if (reader.readU8(length)) {
+            id.resize(length);
+        }
+        if (id.size() != length || !reader.readBytes(id.data(), length)) {
+            return fail(std::string(path) + " has a broken header");
+        }
+        log.parameterIDs.push_back(id);
+    }
+
+    int64_t position = 0;
+    for (;;) {
+        uint8_t kind;
+        uint64_t delta;
+        if (!reader.readU8(kind) || !reader.readVarint(delta)) {
+            break;  // cut short, keep what's there
+        }
+        position += int64_t(delta);
+
+        if (kind == endRecord) {
+            reader.readVarint(log.numDropped);
+            break;
+        }
+        if (kind == blockSizeRecord) {
+            uint64_t blockSize;
+            if (!reader.readVarint(blockSize)) {
+                break;
+            }
+            if (blockSize == 0 || blockSize > uint64_t(std::numeric_limits<int>::max())) {
+                return fail(std::string(path) + " has a broken block size");
+            }
+            log.events.push_back({ position, blockSizeChange, float(blockSize) });
+        } else {
+            float value;
+            if (!reader.readF32(value)) {
+                break;
+            }
+            int parameter = kind - firstParameterRecord;
+            if (parameter >= int(numParameters)) {
+                return fail(std::string(path) + " has a change of a parameter it doesn't list");
+            }
+            log.events.push_back({ position, parameter, value });
+        }
+    }
+    log.length = position;
+
+    std::fclose(file);
+    return {};
+}
+
+Recorder::~Recorder()
+{
+    stop();
+}
+
+bool Recorder::start(const char* path, double sampleRate, const std::vector<std::string>& parameterIDs)
+{
+    if (parameterIDs.size() > size_t(maxParameters)) {
+        return false;
+    }
+    bool expected = false;
+    if (!anyRecording.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+
+    file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        anyRecording.store(false);
+        return false;
+    }
+
+    std::fwrite(magic, 1, 4, file);
+    writeU32(file, version);
+    uint64_t rateBits;
+    std::memcpy(&rateBits, &sampleRate, sizeof(rateBits));
+    writeU32(file, uint32_t(rateBits));
+    writeU32(file, uint32_t(rateBits >> 32));
+    writeU32(file, uint32_t(parameterIDs.size()));
+    for (const auto& id : parameterIDs) {
+        auto length = std::min(id.size(), size_t(255));
+        std::fputc(int(length), file);
+        std::fwrite(id.data(), 1, length, file);
+    }
+
+    if (records == nullptr) {
+        records = std::make_unique<RecordQueue>();
+    }
+    records->discardAll();
+    droppedBefore = records->getNumDropped();
+
+    // NaN, so the first block records every value
+    lastValues.assign(parameterIDs.size(), std::numeric_limits<float>::quiet_NaN());
+    lastBlockSize = 0;
+    samplePosition = 0;
+    lastWrittenPosition = 0;
+
+    quit = false;
+    writer = std::thread([this] { writerLoop(); });
+
+    recording.store(true, std::memory_order_release);
+    return true;
+}
+
+void Recorder::stop()
+{
+    if (!recording.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        quit = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+    records->drain([this] (const Record& record) { write(record); });
+
+    std::fputc(endRecord, file);
+    writeVarint(uint64_t(samplePosition - lastWrittenPosition));
+    writeVarint(records->getNumDropped() - droppedBefore);
+    std::fclose(file);
+    file = nullptr;
+
+    anyRecording.store(false);
+}
+
+void Recorder::setValue(int parameter, float value) noexcept
+{
+    if (!isRecording() || parameter < 0 || parameter >= int(lastValues.size())) {
+        return;
+    }
+    auto& last = lastValues[size_t(parameter)];
+    if (value != last) {
+        last = value;
+        records->push({ samplePosition, parameter, value, 0 });  // dropped (and counted) if the writer fell behind
+    }
+}
+
+void Recorder::endBlock(int numSamples) noexcept
+{
+    if (!isRecording() || numSamples <= 0) {
+        return;
+    }
+    if (numSamples != lastBlockSize) {
+        lastBlockSize = numSamples;
+        records->push({ samplePosition, blockSizeChange, 0.0f, numSamples });
+    }
+    samplePosition += numSamples;
+}
+
+void Recorder::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (!quit) {
+        wakeUp.wait_for(lock, std::chrono::milliseconds(100));
+        records->drain([this] (const Record& record) { write(record); });
+        std::fflush(file);
+    }
+}
+
+void Recorder::write(const Record& record)
+{
+    if (record.parameter == blockSizeChange) {
+        std::fputc(blockSizeRecord, file);
+    } else {
+        std::fputc(firstParameterRecord + record.parameter, file);
+    }
+    writeVarint(uint64_t(record.samplePosition - lastWrittenPosition));
+    lastWrittenPosition = record.samplePosition;
+
+    if (record.parameter == blockSizeChange) {
+        writeVarint(uint64_t(record.blockSize));
+    } else {
+        uint32_t bits;
+        std::memcpy(&bits, &record.value, sizeof(bits));
+        writeU32(file, bits);
+    }
+}
+
+void Recorder::writeVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        std::fputc(int(value & 0x7f) | 0x80, file);
+        value >>= 7;
+    }
+    std::fputc(int(value), file);
+}
+
+}  // namespace AutomationLog
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    AutomationLog.h
+    Created: 19 Oct 2026 2:08:45am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SPSCQueue.h"
+
+// Builds that should capture automation define this as 1. The plugin then logs to the file
+// named by the BROCDELAY_AUTOMATION_FILE environment variable, when it's set.
+#ifndef BROCDELAY_AUTOMATION_CAPTURE
+ #define BROCDELAY_AUTOMATION_CAPTURE 0
+#endif
+
+// Every parameter change the audio thread sees, with the sample position of the block it
+// arrived in, and the size of every block. ProcessBlockBenchmark --replay plays a log back
+// with the same blocks, so a session's automation can be rendered and timed offline.
+//
+// The file is little endian: "BDAL", u32 version, f64 sample rate, u32 number of parameters
+// and each parameter ID as a u8 length and its bytes. Then one record per change:
+//
+//   u8      0 end, 1 block size, 2 + i parameter i
+//   varint  samples since the previous record
+//   then    parameter: f32 normalised value, block size: varint, end: varint records dropped
+//
+// No JUCE in here, so the headless tools can read logs without the plugin.
+namespace AutomationLog
+{
+    // A parameter change or, when parameter is blockSizeChange, the size of the blocks from
+    // here on (in value)
+    struct Event
+    {
+        int64_t samplePosition;
+        int parameter;
+        float value;
+    };
+
+    constexpr int blockSizeChange = -1;
+
+    struct Log
+    {
+        double sampleRate = 0.0;
+        std::vector<std::string> parameterIDs;
+        std::vector<Event> events;  // in the order they happened
+        int64_t length = 0;         // in samples
+        uint64_t numDropped = 0;    // records the writer couldn't keep up with
+    };
+
+    // Returns an empty string when the log was read, otherwise what's wrong with the file. A
+    // log that was cut short (the host crashed) is read up to its last complete record.
+    std::string read(const char* path, Log& log);
+
+    // Records on the audio thread and writes in the background, every 100 ms. Recording never
+    // locks, waits or allocates. Only one Recorder per process records at a time, so with
+    // several plugin instances the first one prepared gets the log.
+    class Recorder
+    {
+    public:
+        Recorder() = default;
+        ~Recorder();
+
+        // Starts a log of the parameters with these IDs. False if a log is already being
+        // written or the file can't be opened. Not real-time safe, like stop(); call them
+        // while the audio thread isn't processing.
+        bool start(const char* path, double sampleRate, const std::vector<std::string>& parameterIDs);
+
+        // Writes the rest and closes the file
+        void stop();
+
+        bool isRecording() const noexcept
+        {
+            return recording.load(std::memory_order_acquire);
+        }
+
+        // Audio thread: the normalised value of parameter i at the start of the block. Only
+        // changes end up in the log.
+        void setValue(int parameter, float value) noexcept;
+
+        // Audio thread: after the values of a block
+        void endBlock(int numSamples) noexcept;
+
+    private:
+        struct Record
+        {
+            int64_t samplePosition;
+            int parameter;  // or blockSizeChange
+            float value;
+            int blockSize;
+        };
+
+        using RecordQueue = SPSCQueue<Record, 16384>;
+
+        void writerLoop();
+        void write(const Record& record);
+        void writeVarint(uint64_t value);
+
+        std::atomic<bool> recording { false };
+
+        // audio thread
+        std::unique_ptr<RecordQueue> records;
+        std::vector<float> lastValues;
+        int lastBlockSize = 0;
+        int64_t samplePosition = 0;
+
+        // writer thread
+        std::FILE* file = nullptr;
+        int64_t lastWrittenPosition = 0;
+        size_t droppedBefore = 0;
+
+        std::thread writer;
+        std::mutex writerMutex;
+        std::condition_variable wakeUp;
+        bool quit = false;
+
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+    };
+}
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    BlockStats.h
+    Created: 18 Oct 2026 5:10:37pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include "SPSCQueue.h"
+
+// What the audio thread reports about every block it renders. The editor drains these at its
+// own pace for the meters; CPU graphs and telemetry can be built on the same records.
+struct BlockStats
+{
+    int64_t samplePosition;  // first sample of the block, counted since prepareToPlay
+    int numSamples;
+    float peakL;
+    float peakR;
+    float rmsL;
+    float rmsR;
+    float truePeakL;         // 0 unless true peak metering is on
+    float truePeakR;
+    float processingTime;    // seconds spent in processBlock, 0 without BROCDELAY_LOAD_METER
+};
+
+// A bit over a second of 64 sample blocks at 48 kHz. When nobody reads (no editor open) new
+// records are simply dropped.
+using BlockStatsQueue = SPSCQueue<BlockStats, 1024>;
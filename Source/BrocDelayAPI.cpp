@@ -0,0 +1,331 @@
+/*
+  ==============================================================================
+
+    BrocDelayAPI.cpp
+    Created: 19 Oct 2026 4:02:51am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <memory>
+#include "BrocDelayAPI.h"
+#include "DelayEngine.h"
+#include "DelayVoiceBatch.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+ #include <xmmintrin.h>
+ #define BROCDELAY_API_HAS_MXCSR 1
+#else
+ #define BROCDELAY_API_HAS_MXCSR 0
+#endif
+
+struct BrocDelay
+{
+    DelayEngine engine;
+
+    // interleaved audio is split into these, a block at a time
+    std::unique_ptr<float[]> left;
+    std::unique_ptr<float[]> right;
+    bool prepared = false;
+};
+
+struct BrocDelayBatch
+{
+    explicit BrocDelayBatch(int numVoices) : voices(numVoices) {}
+
+    DelayVoiceBatch voices;
+};
+
+namespace
+{
+    // What juce::ScopedNoDenormals does for the plugin: the feedback path decays into
+    // denormals, which are slow on x86. Elsewhere they're left to the hardware.
+    class ScopedNoDenormals
+    {
+    public:
+        ScopedNoDenormals() noexcept
+        {
+           #if BROCDELAY_API_HAS_MXCSR
+            csr = _mm_getcsr();
+            _mm_setcsr(csr | 0x8040);  // flush to zero and denormals are zero
+           #endif
+        }
+
+        ~ScopedNoDenormals()
+        {
+           #if BROCDELAY_API_HAS_MXCSR
+            _mm_setcsr(csr);
+           #endif
+        }
+
+    private:
+       #if BROCDELAY_API_HAS_MXCSR
+        unsigned int csr;
+       #endif
+    };
+
+    bool isValidParameter(int index)
+    {
+        return index >= 0 && index < DelayEngine::numParameters;
+    }
+}
+
+BrocDelay* brocdelay_create(void)
+{
+    // nothing may be thrown across the C API
+    try {
+        return new BrocDelay;
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void brocdelay_destroy(BrocDelay* delay)
+{
+    delete delay;
+}
+
+int brocdelay_prepare(BrocDelay* delay, double sampleRate, int maxBlockSize)
+{
+    if (delay == nullptr || !(sampleRate > 0.0) || maxBlockSize < 1) {
+        return -1;
+    }
+    delay->prepared = false;
+    try {
+        delay->engine.prepare(sampleRate, maxBlockSize);
+        delay->left.reset(new float[size_t(maxBlockSize)]);
+        delay->right.reset(new float[size_t(maxBlockSize)]);
+    }
+    catch (...) {
+        // out of memory, or std::system_error when the offline worker thread can't start
+        return -1;
+    }
+    delay->prepared = true;
+    return 0;
+}
+
+void brocdelay_reset(BrocDelay* delay)
+{
+    if (delay != nullptr) {
+        delay->engine.reset();
+    }
+}
+
+void brocdelay_set_offline(BrocDelay* delay, int offline)
+{
+    if (delay != nullptr) {
+        delay->engine.setNonRealtime(offline != 0);
+    }
+}
+
+int brocdelay_get_num_parameters(void)
+{
+    return DelayEngine::numParameters;
+}
+
+const char* brocdelay_get_parameter_id(int index)
+{
+    return isValidParameter(index) ? DelayEngine::getParameterInfo(index).id : nullptr;
+}
+
+int brocdelay_find_parameter(const char* id)
+{
+    return DelayEngine::findParameter(id);
+}
+
+int brocdelay_get_parameter_range(int index, float* minimum, float* maximum, float* defaultValue)
+{
+    if (!isValidParameter(index)) {
+        return -1;
+    }
+    const auto& info = DelayEngine::getParameterInfo(index);
+    if (minimum != nullptr) {
+        *minimum = info.minimum;
+    }
+    if (maximum != nullptr) {
+        *maximum = info.maximum;
+    }
+    if (defaultValue != nullptr) {
+        *defaultValue = info.defaultValue;
+    }
+    return 0;
+}
+
+int brocdelay_set_parameter(BrocDelay* delay, int index, float value)
+{
+    if (delay == nullptr || !isValidParameter(index)) {
+        return -1;
+    }
+    delay->engine.setParameter(index, value);
+    return 0;
+}
+
+float brocdelay_get_parameter(const BrocDelay* delay, int index)
+{
+    if (delay == nullptr || !isValidParameter(index)) {
+        return 0.0f;
+    }
+    return delay->engine.getParameter(index);
+}
+
+void brocdelay_set_tempo(BrocDelay* delay, double bpm)
+{
+    if (delay != nullptr) {
+        delay->engine.setTempo(bpm);
+    }
+}
+
+void brocdelay_set_position(BrocDelay* delay, int64_t timeInSamples)
+{
+    if (delay != nullptr) {
+        delay->engine.setHasPosition(true);
+        delay->engine.setTimeInSamples(timeInSamples);
+    }
+}
+
+void brocdelay_clear_position(BrocDelay* delay)
+{
+    if (delay != nullptr) {
+        delay->engine.setHasPosition(false);
+    }
+}
+
+int brocdelay_process_planar(BrocDelay* delay, const float* const* inputs, float* const* outputs,
+                             int numChannels, int numFrames)
+{
+    if (delay == nullptr || !delay->prepared || inputs == nullptr || outputs == nullptr
+            || (numChannels != 1 && numChannels != 2) || numFrames < 0) {
+        return -1;
+    }
+    ScopedNoDenormals noDenormals;
+    int right = numChannels - 1;
+    delay->engine.process(inputs[0], inputs[right], outputs[0], outputs[right], numFrames);
+    return 0;
+}
+
+int brocdelay_process_interleaved(BrocDelay* delay, const float* input, float* output, int numChannels,
+                                  int numFrames)
+{
+    if (delay == nullptr || !delay->prepared || input == nullptr || output == nullptr
+            || (numChannels != 1 && numChannels != 2) || numFrames < 0) {
+        return -1;
+    }
+    ScopedNoDenormals noDenormals;
+    auto& engine = delay->engine;
+    float* left = delay->left.get();
+    float* right = delay->right.get();
+
+    if (numChannels == 1) {
+        engine.process(input, input, output, output, numFrames);
+        return 0;
+    }
+
+    // a block is read before it's written, so the output may be the input
+    int maxBlockSize = engine.getMaxBlockSize();
+    for (int offset = 0; offset < numFrames; offset += maxBlockSize) {
+        int blockSize = std::min(maxBlockSize, numFrames - offset);
+        const float* source = input + size_t(offset) * 2;
+        for (int i = 0; i < blockSize; ++i) {
+            left[i] = source[i * 2];
+            right[i] = source[i * 2 + 1];
+        }
+
+        engine.processBlock(left, right, left, right, blockSize);
+
+        float* dest = output + size_t(offset) * 2;
+        for (int i = 0; i < blockSize; ++i) {
+            dest[i * 2] = left[i];
+            dest[i * 2 + 1] = right[i];
+        }
+    }
+    return 0;
+}
+
+double brocdelay_get_tail_seconds(const BrocDelay* delay)
+{
+    return delay != nullptr ? delay->engine.getTailLengthSeconds() : 0.0;
+}
+
+BrocDelayBatch* brocdelay_batch_create(int numVoices)
+{
+    if (numVoices < 1) {
+        return nullptr;
+    }
+    try {
+        return new BrocDelayBatch(numVoices);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void brocdelay_batch_destroy(BrocDelayBatch* batch)
+{
+    delete batch;
+}
+
+int brocdelay_batch_get_num_voices(const BrocDelayBatch* batch)
+{
+    return batch != nullptr ? batch->voices.getNumVoices() : 0;
+}
+
+int brocdelay_batch_prepare(BrocDelayBatch* batch, double sampleRate, float maxDelayTime)
+{
+    if (batch == nullptr || !(sampleRate > 0.0) || !(maxDelayTime > 0.0f)) {
+        return -1;
+    }
+    try {
+        batch->voices.prepare(sampleRate, maxDelayTime);
+    }
+    catch (...) {
+        // out of memory, or std::length_error for delay lines too long to index
+        return -1;
+    }
+    return 0;
+}
+
+void brocdelay_batch_reset(BrocDelayBatch* batch)
+{
+    if (batch != nullptr) {
+        batch->voices.reset();
+    }
+}
+
+int brocdelay_batch_set_parameter(BrocDelayBatch* batch, int voice, int index, float value)
+{
+    if (batch == nullptr || !isValidParameter(index) || voice < -1 || voice >= batch->voices.getNumVoices()) {
+        return -1;
+    }
+    if (voice == -1) {
+        batch->voices.setParameter(index, value);
+    } else {
+        batch->voices.setParameter(voice, index, value);
+    }
+    return 0;
+}
+
+float brocdelay_batch_get_parameter(const BrocDelayBatch* batch, int voice, int index)
+{
+    return batch != nullptr ? batch->voices.getParameter(voice, index) : 0.0f;
+}
+
+void brocdelay_batch_set_tempo(BrocDelayBatch* batch, double bpm)
+{
+    if (batch != nullptr) {
+        batch->voices.setTempo(bpm);
+    }
+}
+
+int brocdelay_batch_process(BrocDelayBatch* batch, const float* input, float* output, int numFrames)
+{
+    if (batch == nullptr || !batch->voices.isPrepared() || input == nullptr || output == nullptr
+            || numFrames < 0) {
+        return -1;
+    }
+    ScopedNoDenormals noDenormals;
+    batch->voices.process(input, output, numFrames);
+    return 0;
+}
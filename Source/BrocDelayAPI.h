@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    BrocDelayAPI.h
+    Created: 19 Oct 2026 4:02:51am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+    The delay as a C library (BrocDelayCore), for programs that want the DSP without a plugin
+    host, JUCE or a GUI. A thin layer over DelayEngine.
+
+        BrocDelay* delay = brocdelay_create();
+        brocdelay_set_parameter(delay, brocdelay_find_parameter("feedback"), 60.0f);
+        brocdelay_prepare(delay, 48000.0, 512);
+        brocdelay_process_interleaved(delay, input, output, 2, numFrames);
+        ...
+        brocdelay_destroy(delay);
+
+    Parameters are set in the units the plugin shows: ms, %, dB and Hz, 0 or 1 for switches
+    and the index for choices. Out of range values are clamped. They take effect at the start
+    of the next block, smoothed like in the plugin.
+
+    Audio is 1 (mono) or 2 (stereo) channels of 32 bit float, in and out the same. Any number
+    of frames can be processed at once and the output may be the input. Processing doesn't
+    allocate, lock or wait unless brocdelay_set_offline() is on.
+
+    An instance may only be used by one thread at a time. Different instances are independent.
+*/
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+ #if defined(BROCDELAY_API_EXPORTS)
+  #define BROCDELAY_API __declspec(dllexport)
+ #elif defined(BROCDELAY_API_SHARED)
+  #define BROCDELAY_API __declspec(dllimport)
+ #else
+  #define BROCDELAY_API
+ #endif
+#elif defined(__GNUC__)
+ #define BROCDELAY_API __attribute__((visibility("default")))
+#else
+ #define BROCDELAY_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BrocDelay BrocDelay;
+
+/* Returns NULL when out of memory. The parameters start at their defaults. */
+BROCDELAY_API BrocDelay* brocdelay_create(void);
+BROCDELAY_API void brocdelay_destroy(BrocDelay* delay);
+
+/* Allocates for the sample rate and resets. Must be called before processing, and again when
+   the sample rate changes. maxBlockSize only sets how many frames are processed at a time
+   internally. Returns 0, or -1 for bad arguments, when out of memory or when the offline worker
+   thread can't be started. */
+BROCDELAY_API int brocdelay_prepare(BrocDelay* delay, double sampleRate, int maxBlockSize);
+
+/* Clears the echoes and jumps the smoothed parameters to their values */
+BROCDELAY_API void brocdelay_reset(BrocDelay* delay);
+
+/* For renders that don't have to keep up with real time: the two channels of larger blocks
+   are processed on two threads. Takes effect at the next brocdelay_prepare(). */
+BROCDELAY_API void brocdelay_set_offline(BrocDelay* delay, int offline);
+
+BROCDELAY_API int brocdelay_get_num_parameters(void);
+
+/* The plugin's ID of parameter index ("delayTime", "feedback", ...), NULL if there's none */
+BROCDELAY_API const char* brocdelay_get_parameter_id(int index);
+
+/* The index of the parameter with this ID, -1 if there's none */
+BROCDELAY_API int brocdelay_find_parameter(const char* id);
+
+/* Any of the pointers may be NULL. Returns 0, or -1 for a bad index. */
+BROCDELAY_API int brocdelay_get_parameter_range(int index, float* minimum, float* maximum, float* defaultValue);
+
+/* Returns 0, or -1 for a bad index */
+BROCDELAY_API int brocdelay_set_parameter(BrocDelay* delay, int index, float value);
+BROCDELAY_API float brocdelay_get_parameter(const BrocDelay* delay, int index);
+
+/* The tempo tempo sync follows, 120 bpm until it's set */
+BROCDELAY_API void brocdelay_set_tempo(BrocDelay* delay, double bpm);
+
+/* Where a host's transport is at the start of the next block, in samples. Optional; when it
+   jumps back (looping) the delay ducks while its time changes, like in the plugin. */
+BROCDELAY_API void brocdelay_set_position(BrocDelay* delay, int64_t timeInSamples);
+
+/* Back to no position, as before the first brocdelay_set_position(), e.g. when the transport
+   stops reporting one. Nothing ducks for a loop until a position is set again. */
+BROCDELAY_API void brocdelay_clear_position(BrocDelay* delay);
+
+/* inputs and outputs hold numChannels pointers to numFrames samples each. Returns 0, or -1
+   for bad arguments or when the instance isn't prepared. */
+BROCDELAY_API int brocdelay_process_planar(BrocDelay* delay, const float* const* inputs, float* const* outputs,
+                                           int numChannels, int numFrames);
+
+/* input and output hold numFrames frames of numChannels samples each */
+BROCDELAY_API int brocdelay_process_interleaved(BrocDelay* delay, const float* input, float* output,
+                                                int numChannels, int numFrames);
+
+/* How long the echoes take to die away after the input stops, for the current parameters
+   and tempo. Infinite (HUGE_VAL) at 100% feedback or more. */
+BROCDELAY_API double brocdelay_get_tail_seconds(const BrocDelay* delay);
+
+/*
+    Batches of mono delays, for rendering many voices at once. The voices are processed side by
+    side in vector lanes, so a batch is much cheaper than as many BrocDelay instances. A voice
+    has the same parameters as a BrocDelay, except that flip flop and the shift modes don't
+    apply: its delay time always glides (repitches).
+
+        BrocDelayBatch* batch = brocdelay_batch_create(256);
+        brocdelay_batch_set_parameter(batch, voice, brocdelay_find_parameter("delayTime"), 250.0f);
+        brocdelay_batch_prepare(batch, 48000.0, 1000.0f);
+        brocdelay_batch_process(batch, input, output, numFrames);
+
+    Audio is 32 bit float, one frame after the other: sample i of voice v is at
+    [i * brocdelay_batch_get_num_voices(batch) + v]. Processing doesn't allocate, lock or wait.
+*/
+
+typedef struct BrocDelayBatch BrocDelayBatch;
+
+/* numVoices is rounded up to a multiple of 16. Returns NULL when out of memory. */
+BROCDELAY_API BrocDelayBatch* brocdelay_batch_create(int numVoices);
+BROCDELAY_API void brocdelay_batch_destroy(BrocDelayBatch* batch);
+
+BROCDELAY_API int brocdelay_batch_get_num_voices(const BrocDelayBatch* batch);
+
+/* Allocates delay lines of up to maxDelayTime ms (5000 at most) for every voice and resets.
+   Returns 0, or -1 for bad arguments or when out of memory. */
+BROCDELAY_API int brocdelay_batch_prepare(BrocDelayBatch* batch, double sampleRate, float maxDelayTime);
+
+BROCDELAY_API void brocdelay_batch_reset(BrocDelayBatch* batch);
+
+/* A voice of -1 sets the parameter of every voice. Returns 0, or -1 for a bad voice or index. */
+BROCDELAY_API int brocdelay_batch_set_parameter(BrocDelayBatch* batch, int voice, int index, float value);
+BROCDELAY_API float brocdelay_batch_get_parameter(const BrocDelayBatch* batch, int voice, int index);
+
+BROCDELAY_API void brocdelay_batch_set_tempo(BrocDelayBatch* batch, double bpm);
+
+/* input and output hold numFrames frames and may be the same. Returns 0, or -1 for bad
+   arguments or when the batch isn't prepared. */
+BROCDELAY_API int brocdelay_batch_process(BrocDelayBatch* batch, const float* input, float* output, int numFrames);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    CacheLine.h
+    Created: 18 Oct 2026 3:40:52pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+
+// Size used to keep data written by the audio thread away from data touched by other threads.
+// Not std::hardware_destructive_interference_size, which isn't available everywhere and
+// changes with compiler flags. Apple silicon uses 128 byte lines.
+#if defined(__APPLE__) && defined(__aarch64__)
+inline constexpr std::size_t cacheLineSize = 128;
+#else
+inline constexpr std::size_t cacheLineSize = 64;
+#endif
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    DSPKernels.cpp
+    Created: 18 Oct 2026 10:04:12am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "DSPKernels.h"
+
+#if BROCDELAY_X86_KERNELS
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+  #include <immintrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+namespace DSPKernels
+{
+
+namespace
+{
+   #if BROCDELAY_X86_KERNELS
+    struct CPUFeatures
+    {
+        bool sse2 = false;
+        bool avx2 = false;
+        bool avx512 = false;
+    };
+
+    void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int (&regs)[4]) noexcept
+    {
+       #if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, int(leaf), int(subleaf));
+        for (int i = 0; i < 4; ++i) {
+            regs[i] = static_cast<unsigned int>(r[i]);
+        }
+       #else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+       #endif
+    }
+
+    unsigned long long xgetbv() noexcept
+    {
+       #if defined(_MSC_VER)
+        return _xgetbv(0);
+       #else
+        unsigned int lo, hi;
+        __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<unsigned long long>(hi) << 32) | lo;
+       #endif
+    }
+
+    CPUFeatures detectFeatures() noexcept
+    {
+        CPUFeatures features;
+
+        unsigned int regs[4];
+        cpuid(0, 0, regs);
+        unsigned int maxLeaf = regs[0];
+
+        cpuid(1, 0, regs);
+        features.sse2 = (regs[3] >> 26) & 1;
+
+        bool osxsave = (regs[2] >> 27) & 1;
+        bool avx = (regs[2] >> 28) & 1;
+        if (!osxsave || !avx || maxLeaf < 7) {
+            return features;
+        }
+
+        // the OS must save the YMM (and for AVX-512 also the opmask and ZMM) registers
+        auto xcr0 = xgetbv();
+        bool ymmEnabled = (xcr0 & 0x06) == 0x06;
+        bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+
+        cpuid(7, 0, regs);
+        features.avx2 = ymmEnabled && ((regs[1] >> 5) & 1);
+        features.avx512 = zmmEnabled && ((regs[1] >> 16) & 1);
+        return features;
+    }
+
+    const CPUFeatures& getFeatures() noexcept
+    {
+        static const CPUFeatures features = detectFeatures();
+        return features;
+    }
+   #endif
+
+    std::atomic<const KernelTable*> overrideTable { nullptr };
+
+    const KernelTable& getDetectedTable() noexcept
+    {
+        static const KernelTable& table = [] () -> const KernelTable& {
+            if (const char* requested = std::getenv("BROCDELAY_ISA")) {
+                for (auto isa : { ISA::GENERIC, ISA::SSE2, ISA::AVX2, ISA::AVX512 }) {
+                    if (std::strcmp(requested, getName(isa)) == 0) {
+                        if (auto* table = getTable(isa)) {
+                            return *table;
+                        }
+                    }
+                }
+            }
+            return *getTable(detectBestISA());
+        }();
+        return table;
+    }
+}
+
+const KernelTable& get() noexcept
+{
+    if (auto* table = overrideTable.load(std::memory_order_acquire)) {
+        return *table;
+    }
+    return getDetectedTable();
+}
+
+bool setOverride(ISA isa) noexcept
+{
+    auto* table = getTable(isa);
+    if (table == nullptr) {
+        return false;
+    }
+    overrideTable.store(table, std::memory_order_release);
+    return true;
+}
+
+void clearOverride() noexcept
+{
+    overrideTable.store(nullptr, std::memory_order_release);
+}
+
+bool isSupported(ISA isa) noexcept
+{
+    switch (isa) {
+       #if BROCDELAY_X86_KERNELS
+        case ISA::SSE2:   return getFeatures().sse2;
+        case ISA::AVX2:   return getFeatures().avx2;
+        case ISA::AVX512: return getFeatures().avx512;
+       #endif
+        case ISA::GENERIC: return true;
+        default: return false;
+    }
+}
+
+ISA detectBestISA() noexcept
+{
+    for (auto isa : { ISA::AVX512, ISA::AVX2, ISA::SSE2 }) {
+        if (isSupported(isa)) {
+            return isa;
+        }
+    }
+    return ISA::GENERIC;
+}
+
+const KernelTable* getTable(ISA isa) noexcept
+{
+    if (!isSupported(isa)) {
+        return nullptr;
+    }
+
+    switch (isa) {
+       #if BROCDELAY_X86_KERNELS
+        case ISA::SSE2:   return &SSE2::getTable();
+        case ISA::AVX2:   return &AVX2::getTable();
+        case ISA::AVX512: return &AVX512::getTable();
+       #endif
+        case ISA::GENERIC: return &Generic::getTable();
+        default: return nullptr;
+    }
+}
+
+const char* getName(ISA isa) noexcept
+{
+    switch (isa) {
+        case ISA::SSE2:   return "sse2";
+        case ISA::AVX2:   return "avx2";
+        case ISA::AVX512: return "avx512";
+        default:          return "generic";
+    }
+}
+
+float cutFilterR2() noexcept
+{
+    auto resonance = static_cast<float>(1.0 / std::sqrt(2.0));
+    return static_cast<float>(1.0 / resonance);
+}
+
+void cutFilterCoefficients(float cutoff, double sampleRate, float R2, float& g, float& h) noexcept
+{
+    g = static_cast<float>(std::tan(3.141592653589793238 * cutoff / sampleRate));
+    h = static_cast<float>(1.0 / (1.0 + R2 * g + g * g));
+}
+
+}
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    DSPKernels.h
+    Created: 18 Oct 2026 10:04:12am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Block kernels for the hot parts of the delay, compiled once per instruction set in
+// DSPKernelsGeneric.cpp, DSPKernelsSSE2.cpp, DSPKernelsAVX2.cpp and DSPKernelsAVX512.cpp.
+// The best table for the current CPU is picked the first time get() is called.
+//
+// This header (and the kernel translation units) deliberately don't depend on JUCE so the
+// kernels can also be built into the headless benchmarks.
+
+namespace DSPKernels
+{
+    enum class ISA {
+        GENERIC,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    // State of the low cut (highpass) and high cut (lowpass) TPT state variable filters of one channel
+    struct CutFilterState
+    {
+        float lowCutS1 = 0.0f;
+        float lowCutS2 = 0.0f;
+        float highCutS1 = 0.0f;
+        float highCutS2 = 0.0f;
+    };
+
+    // Per-sample coefficients for both cut filters, as computed by cutFilterCoefficients()
+    struct CutFilterCoefficients
+    {
+        const float* lowCutG;
+        const float* lowCutH;
+        const float* highCutG;
+        const float* highCutH;
+        float R2;
+    };
+
+    // A batch of independent mono delays (DelayVoiceBatch) processed side by side, one voice per
+    // vector lane, so the kernel advances 4 (SSE2), 8 (AVX2) or 16 (AVX-512) voices per instruction.
+    // Everything is stored voice by voice: a frame of audio is numVoices samples, and each of the
+    // VoiceState entries below is an array of numVoices values.
+    inline constexpr int maxVoiceLanes = 16;
+
+    enum VoiceState
+    {
+        voiceDelay,             // where the delay line is read, in samples
+        voiceTargetDelay,       // what voiceDelay glides to (one pole, batch.delayCoeff)
+        voiceFeedback,          // the feedback gain and how much it changes per sample
+        voiceFeedbackStep,
+        voiceLowCutG,           // cut filter coefficients, ramped per sample like the gains
+        voiceLowCutGStep,
+        voiceLowCutH,
+        voiceLowCutHStep,
+        voiceHighCutG,
+        voiceHighCutGStep,
+        voiceHighCutH,
+        voiceHighCutHStep,
+        voiceDryGain,           // output gain of the input
+        voiceDryGainStep,
+        voiceWetGain,           // output gain of the echoes
+        voiceWetGainStep,
+        voiceLowCutS1,          // filter state, see CutFilterState
+        voiceLowCutS2,
+        voiceHighCutS1,
+        voiceHighCutS2,
+        voiceFeedbackSample,    // the feedback of the previous sample, written with the next one
+        numVoiceStates
+    };
+
+    struct VoiceBatch
+    {
+        float* states;      // numVoiceStates arrays of numVoices values
+        float* buffer;      // the delay lines, frame after frame: voice v of frame f is at f * numVoices + v
+        int numVoices;      // a multiple of maxVoiceLanes
+        int bufferLength;   // in frames, bufferLength * numVoices has to fit in an int
+        int writeIndex;     // the last frame written
+        float delayCoeff;
+        float R2;
+
+        float* get(int state) const noexcept
+        {
+            return states + state * numVoices;
+        }
+    };
+
+    // ITU-R BS.1770-4 annex 2 interpolation filter: four phases of 12 taps that upsample by 4x.
+    // truePeak() needs the last truePeakHistory samples of the previous block in front of the data.
+    inline constexpr int truePeakPhases = 4;
+    inline constexpr int truePeakTaps = 12;
+    inline constexpr int truePeakHistory = truePeakTaps - 1;
+
+    inline constexpr float truePeakCoefficients[truePeakPhases][truePeakTaps] {
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+          -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+           0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+          -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+           0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+          -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+           0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+          -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+           0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+    };
+
+    struct KernelTable
+    {
+        ISA isa;
+        const char* name;
+
+        // Writes a block into a circular buffer, advancing writeIndex exactly like DelayLine::write
+        void (*write)(float* buffer, int bufferLength, int& writeIndex,
+                      const float* input, int numSamples) noexcept;
+
+        // Reads a block of linearly interpolated samples. Sample i is read as if it had just been
+        // written after writeIndex, so delays[i] must be at least i + 1 (nothing unwritten is read).
+        void (*read)(const float* buffer, int bufferLength, int writeIndex,
+                     const float* delays, float* output, int numSamples) noexcept;
+
+        // dest = (1 - amount) * dest + amount * other
+        void (*crossfade)(float* dest, const float* other, const float* amount, int numSamples) noexcept;
+
+        // dest = source * gains (source and dest may be the same)
+        void (*multiply)(const float* source, const float* gains, float* dest, int numSamples) noexcept;
+
+        // dest = a + b (a or b may be the same as dest)
+        void (*add)(const float* a, const float* b, float* dest, int numSamples) noexcept;
+
+        // Low cut followed by high cut, in place
+        void (*cutFilters)(float* data, int numSamples, const CutFilterCoefficients& coeffs,
+                           CutFilterState& state) noexcept;
+
+        // Builds the delay line inputs from the dry signal and the previous sample's feedback,
+        // swapping the stereo field by invert[i] (0 = no swap, 1 = full flip flop)
+        void (*feedbackInput)(const float* dryL, const float* dryR,
+                              const float* feedbackL, const float* feedbackR,
+                              const float* invert, float* outputL, float* outputR,
+                              int numSamples) noexcept;
+
+        // output = (dry * dryGain + wet * wetGain * mix) * gain
+        void (*mixGain)(const float* dry, const float* wet,
+                        const float* dryGain, const float* wetGain,
+                        const float* mix, const float* gain,
+                        float* output, int numSamples) noexcept;
+
+        // Largest absolute sample value in the block (NaNs are ignored)
+        float (*peak)(const float* data, int numSamples) noexcept;
+
+        // Sum of the squared samples, for RMS. Accumulated in sample order in double precision
+        // (the same in every table, a vectorised sum would add in a different order).
+        double (*sumOfSquares)(const float* data, int numSamples) noexcept;
+
+        // Largest absolute value of the 4x upsampled signal (the true peak). data[-truePeakHistory]
+        // up to data[-1] are read too and must hold the samples before the block.
+        float (*truePeak)(const float* data, int numSamples) noexcept;
+
+        // Widens [minValue, maxValue] to take in every sample of the block (NaNs are ignored).
+        // Start from +inf / -inf to get the range of a single block.
+        void (*minMax)(const float* data, int numSamples, float& minValue, float& maxValue) noexcept;
+
+        // Advances every voice of the batch by numSamples frames. A voice reads its delay line,
+        // runs the echo through the cut filters and writes its input plus the feedback back,
+        // like one channel of DelayEngine; the ramps (the Step states) move once per sample.
+        // input and output hold numSamples frames and may be the same.
+        void (*voices)(VoiceBatch& batch, const float* input, float* output, int numSamples) noexcept;
+    };
+
+    // The kernel table used by the plugin. Chosen once from cpuid, unless the BROCDELAY_ISA
+    // environment variable ("generic", "sse2", "avx2", "avx512") or setOverride() says otherwise.
+    const KernelTable& get() noexcept;
+
+    // Forces a specific table, e.g. to test a variant on a machine that supports a wider one.
+    // Returns false (and changes nothing) if that variant can't run here. Not real-time safe to
+    // call while audio is being processed.
+    bool setOverride(ISA isa) noexcept;
+
+    // Goes back to the automatically detected table
+    void clearOverride() noexcept;
+
+    bool isSupported(ISA isa) noexcept;
+    ISA detectBestISA() noexcept;
+
+    // The table for a given instruction set, or nullptr if it wasn't compiled in or can't run here
+    const KernelTable* getTable(ISA isa) noexcept;
+
+    const char* getName(ISA isa) noexcept;
+
+    // Same math as juce::dsp::StateVariableTPTFilter::update() with the default resonance
+    float cutFilterR2() noexcept;
+    void cutFilterCoefficients(float cutoff, double sampleRate, float R2, float& g, float& h) noexcept;
+
+    namespace Generic { const KernelTable& getTable() noexcept; }
+   #if defined(__x86_64__) || defined(_M_X64)
+    #define BROCDELAY_X86_KERNELS 1
+    namespace SSE2 { const KernelTable& getTable() noexcept; }
+    namespace AVX2 { const KernelTable& getTable() noexcept; }
+    namespace AVX512 { const KernelTable& getTable() noexcept; }
+   #else
+    #define BROCDELAY_X86_KERNELS 0
+   #endif
+}
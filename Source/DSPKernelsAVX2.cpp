@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    DSPKernelsAVX2.cpp
+    Created: 18 Oct 2026 11:06:14am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "DSPKernels.h"
+
+#if BROCDELAY_X86_KERNELS
+
+#include <immintrin.h>
+
+// FMA is left out on purpose, every variant has to produce the same output as the generic
+// kernels. (MSVC has no per-function targets; there only the intrinsics below use AVX2.)
+#define DSP_KERNELS_NAMESPACE AVX2
+#if defined(_MSC_VER) && !defined(__clang__)
+ #define DSP_KERNELS_TARGET
+#else
+ #define DSP_KERNELS_TARGET __attribute__((target("avx2")))
+#endif
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels::AVX2
+{
+
+namespace
+{
+    DSP_KERNELS_TARGET void vectorRead(const float* buffer, int bufferLength, int writeIndex,
+                                       const float* delays, float* output, int numSamples) noexcept
+    {
+        const __m256i length = _mm256_set1_epi32(bufferLength);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i step = _mm256_set1_epi32(8);
+        __m256i position = _mm256_add_epi32(_mm256_set1_epi32(writeIndex + 1),
+                                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            __m256 delay = _mm256_loadu_ps(delays + i);
+            __m256i integerDelay = _mm256_cvttps_epi32(delay);
+
+            __m256i readIndexA = _mm256_sub_epi32(position, integerDelay);
+            readIndexA = _mm256_add_epi32(readIndexA, _mm256_and_si256(_mm256_cmpgt_epi32(zero, readIndexA), length));
+            __m256i readIndexB = _mm256_sub_epi32(readIndexA, one);
+            readIndexB = _mm256_add_epi32(readIndexB, _mm256_and_si256(_mm256_cmpgt_epi32(zero, readIndexB), length));
+
+            __m256 sampleA = _mm256_i32gather_ps(buffer, readIndexA, 4);
+            __m256 sampleB = _mm256_i32gather_ps(buffer, readIndexB, 4);
+            __m256 fraction = _mm256_sub_ps(delay, _mm256_cvtepi32_ps(integerDelay));
+            _mm256_storeu_ps(output + i, _mm256_add_ps(sampleA, _mm256_mul_ps(fraction, _mm256_sub_ps(sampleB, sampleA))));
+
+            position = _mm256_add_epi32(position, step);
+        }
+        for (; i < numSamples; ++i) {
+            output[i] = readSample(buffer, bufferLength, writeIndex, delays[i], i);
+        }
+    }
+
+    DSP_KERNELS_TARGET void vectorCrossfade(float* dest, const float* other, const float* amount,
+                                            int numSamples) noexcept
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            __m256 x = _mm256_loadu_ps(amount + i);
+            __m256 a = _mm256_mul_ps(_mm256_sub_ps(one, x), _mm256_loadu_ps(dest + i));
+            __m256 b = _mm256_mul_ps(x, _mm256_loadu_ps(other + i));
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(a, b));
+        }
+        crossfade(dest + i, other + i, amount + i, numSamples - i);
+    }
+
+    DSP_KERNELS_TARGET void vectorMultiply(const float* source, const float* gains, float* dest,
+                                           int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            _mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_loadu_ps(source + i), _mm256_loadu_ps(gains + i)));
+        }
+        multiply(source + i, gains + i, dest + i, numSamples - i);
+    }
+
+    DSP_KERNELS_TARGET void vectorMixGain(const float* dry, const float* wet, const float* dryGain,
+                                          const float* wetGain, const float* mix, const float* gain,
+                                          float* output, int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            __m256 d = _mm256_mul_ps(_mm256_loadu_ps(dry + i), _mm256_loadu_ps(dryGain + i));
+            __m256 w = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(wet + i), _mm256_loadu_ps(wetGain + i)),
+                                     _mm256_loadu_ps(mix + i));
+            _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_add_ps(d, w), _mm256_loadu_ps(gain + i)));
+        }
+        mixGain(dry + i, wet + i, dryGain + i, wetGain + i, mix + i, gain + i, output + i, numSamples - i);
+    }
+
+    DSP_KERNELS_TARGET float vectorPeak(const float* data, int numSamples) noexcept
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 maxValue = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            maxValue = _mm256_max_ps(_mm256_andnot_ps(signMask, _mm256_loadu_ps(data + i)), maxValue);
+        }
+
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, maxValue);
+        float result = peak(data + i, numSamples - i);
+        for (float lane : lanes) {
+            result = std::max(result, lane);
+        }
+        return result;
+    }
+
+    DSP_KERNELS_TARGET float vectorTruePeak(const float* data, int numSamples) noexcept
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 maxValue = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            for (int phase = 0; phase < truePeakPhases; ++phase) {
+                __m256 sum = _mm256_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap) {
+                    __m256 product = _mm256_mul_ps(_mm256_set1_ps(truePeakCoefficients[phase][tap]),
+                                                   _mm256_loadu_ps(data + i - tap));
+                    sum = _mm256_add_ps(sum, product);
+                }
+                maxValue = _mm256_max_ps(_mm256_andnot_ps(signMask, sum), maxValue);
+            }
+        }
+
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, maxValue);
+        float result = truePeak(data + i, numSamples - i);
+        for (float lane : lanes) {
+            result = std::max(result, lane);
+        }
+        return result;
+    }
+
+    DSP_KERNELS_TARGET void vectorMinMax(const float* data, int numSamples, float& minValue,
+                                         float& maxValue) noexcept
+    {
+        __m256 low = _mm256_set1_ps(minValue);
+        __m256 high = _mm256_set1_ps(maxValue);
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8) {
+            __m256 x = _mm256_loadu_ps(data + i);
+            low = _mm256_min_ps(x, low);
+            high = _mm256_max_ps(x, high);
+        }
+
+        alignas(32) float lowLanes[8];
+        alignas(32) float highLanes[8];
+        _mm256_store_ps(lowLanes, low);
+        _mm256_store_ps(highLanes, high);
+        minMax(data + i, numSamples - i, minValue, maxValue);
+        for (int lane = 0; lane < 8; ++lane) {
+            minValue = std::min(minValue, lowLanes[lane]);
+            maxValue = std::max(maxValue, highLanes[lane]);
+        }
+    }
+
+    DSP_KERNELS_TARGET void vectorVoices(VoiceBatch& batch, const float* input, float* output, int numSamples) noexcept
+    {
+        // same as voices(), a vector of voices at a time
+        const int numVoices = batch.numVoices;
+        const int bufferLength = batch.bufferLength;
+        const __m256i length = _mm256_set1_epi32(bufferLength);
+        const __m256i stride = _mm256_set1_epi32(numVoices);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256 delayCoeff = _mm256_set1_ps(batch.delayCoeff);
+        const __m256 R2 = _mm256_set1_ps(batch.R2);
+
+        for (int v = 0; v < numVoices; v += 8) {
+            float* lanes = batch.buffer + v;
+            __m256 delay = _mm256_loadu_ps(batch.get(voiceDelay) + v);
+            const __m256 targetDelay = _mm256_loadu_ps(batch.get(voiceTargetDelay) + v);
+            __m256 feedback = _mm256_loadu_ps(batch.get(voiceFeedback) + v);
+            const __m256 feedbackStep = _mm256_loadu_ps(batch.get(voiceFeedbackStep) + v);
+            __m256 lowCutG = _mm256_loadu_ps(batch.get(voiceLowCutG) + v);
+            const __m256 lowCutGStep = _mm256_loadu_ps(batch.get(voiceLowCutGStep) + v);
+            __m256 lowCutH = _mm256_loadu_ps(batch.get(voiceLowCutH) + v);
+            const __m256 lowCutHStep = _mm256_loadu_ps(batch.get(voiceLowCutHStep) + v);
+            __m256 highCutG = _mm256_loadu_ps(batch.get(voiceHighCutG) + v);
+            const __m256 highCutGStep = _mm256_loadu_ps(batch.get(voiceHighCutGStep) + v);
+            __m256 highCutH = _mm256_loadu_ps(batch.get(voiceHighCutH) + v);
+            const __m256 highCutHStep = _mm256_loadu_ps(batch.get(voiceHighCutHStep) + v);
+            __m256 dryGain = _mm256_loadu_ps(batch.get(voiceDryGain) + v);
+            const __m256 dryGainStep = _mm256_loadu_ps(batch.get(voiceDryGainStep) + v);
+            __m256 wetGain = _mm256_loadu_ps(batch.get(voiceWetGain) + v);
+            const __m256 wetGainStep = _mm256_loadu_ps(batch.get(voiceWetGainStep) + v);
+            __m256 lowS1 = _mm256_loadu_ps(batch.get(voiceLowCutS1) + v);
+            __m256 lowS2 = _mm256_loadu_ps(batch.get(voiceLowCutS2) + v);
+            __m256 highS1 = _mm256_loadu_ps(batch.get(voiceHighCutS1) + v);
+            __m256 highS2 = _mm256_loadu_ps(batch.get(voiceHighCutS2) + v);
+            __m256 feedbackSample = _mm256_loadu_ps(batch.get(voiceFeedbackSample) + v);
+
+            int writeIndex = batch.writeIndex;
+            for (int i = 0; i < numSamples; ++i) {
+                int next = writeIndex + 1;
+                if (next >= bufferLength) next = 0;
+
+                delay = _mm256_add_ps(delay, _mm256_mul_ps(_mm256_sub_ps(targetDelay, delay), delayCoeff));
+
+                __m256i integerDelay = _mm256_cvttps_epi32(delay);
+                __m256i readIndexA = _mm256_sub_epi32(_mm256_set1_epi32(next), integerDelay);
+                readIndexA = _mm256_add_epi32(readIndexA, _mm256_and_si256(_mm256_cmpgt_epi32(zero, readIndexA), length));
+                __m256i readIndexB = _mm256_sub_epi32(readIndexA, one);
+                readIndexB = _mm256_add_epi32(readIndexB, _mm256_and_si256(_mm256_cmpgt_epi32(zero, readIndexB), length));
+
+                __m256 sampleA = _mm256_i32gather_ps(lanes, _mm256_add_epi32(_mm256_mullo_epi32(readIndexA, stride), laneOffsets), 4);
+                __m256 sampleB = _mm256_i32gather_ps(lanes, _mm256_add_epi32(_mm256_mullo_epi32(readIndexB, stride), laneOffsets), 4);
+                __m256 fraction = _mm256_sub_ps(delay, _mm256_cvtepi32_ps(integerDelay));
+                __m256 wet = _mm256_add_ps(sampleA, _mm256_mul_ps(fraction, _mm256_sub_ps(sampleB, sampleA)));
+
+                __m256 g = lowCutG;
+                __m256 yHP = _mm256_mul_ps(lowCutH, _mm256_sub_ps(_mm256_sub_ps(wet, _mm256_mul_ps(lowS1, _mm256_add_ps(g, R2))), lowS2));
+                __m256 yBP = _mm256_add_ps(_mm256_mul_ps(yHP, g), lowS1);
+                lowS1 = _mm256_add_ps(_mm256_mul_ps(yHP, g), yBP);
+                __m256 yLP = _mm256_add_ps(_mm256_mul_ps(yBP, g), lowS2);
+                lowS2 = _mm256_add_ps(_mm256_mul_ps(yBP, g), yLP);
+
+                g = highCutG;
+                __m256 hp = _mm256_mul_ps(highCutH, _mm256_sub_ps(_mm256_sub_ps(yHP, _mm256_mul_ps(highS1, _mm256_add_ps(g, R2))), highS2));
+                __m256 bp = _mm256_add_ps(_mm256_mul_ps(hp, g), highS1);
+                highS1 = _mm256_add_ps(_mm256_mul_ps(hp, g), bp);
+                __m256 lp = _mm256_add_ps(_mm256_mul_ps(bp, g), highS2);
+                highS2 = _mm256_add_ps(_mm256_mul_ps(bp, g), lp);
+
+                __m256 x = _mm256_loadu_ps(input + i * numVoices + v);
+                _mm256_storeu_ps(lanes + next * numVoices, _mm256_add_ps(x, feedbackSample));
+                feedbackSample = _mm256_mul_ps(lp, feedback);
+                _mm256_storeu_ps(output + i * numVoices + v, _mm256_add_ps(_mm256_mul_ps(x, dryGain), _mm256_mul_ps(lp, wetGain)));
+
+                feedback = _mm256_add_ps(feedback, feedbackStep);
+                lowCutG = _mm256_add_ps(lowCutG, lowCutGStep);
+                lowCutH = _mm256_add_ps(lowCutH, lowCutHStep);
+                highCutG = _mm256_add_ps(highCutG, highCutGStep);
+                highCutH = _mm256_add_ps(highCutH, highCutHStep);
+                dryGain = _mm256_add_ps(dryGain, dryGainStep);
+                wetGain = _mm256_add_ps(wetGain, wetGainStep);
+                writeIndex = next;
+            }
+
+            _mm256_storeu_ps(batch.get(voiceDelay) + v, delay);
+            _mm256_storeu_ps(batch.get(voiceFeedback) + v, feedback);
+            _mm256_storeu_ps(batch.get(voiceLowCutG) + v, lowCutG);
+            _mm256_storeu_ps(batch.get(voiceLowCutH) + v, lowCutH);
+            _mm256_storeu_ps(batch.get(voiceHighCutG) + v, highCutG);
+            _mm256_storeu_ps(batch.get(voiceHighCutH) + v, highCutH);
+            _mm256_storeu_ps(batch.get(voiceDryGain) + v, dryGain);
+            _mm256_storeu_ps(batch.get(voiceWetGain) + v, wetGain);
+            _mm256_storeu_ps(batch.get(voiceLowCutS1) + v, lowS1);
+            _mm256_storeu_ps(batch.get(voiceLowCutS2) + v, lowS2);
+            _mm256_storeu_ps(batch.get(voiceHighCutS1) + v, highS1);
+            _mm256_storeu_ps(batch.get(voiceHighCutS2) + v, highS2);
+            _mm256_storeu_ps(batch.get(voiceFeedbackSample) + v, feedbackSample);
+        }
+        batch.writeIndex = advanceWriteIndex(batch.writeIndex, batch.bufferLength, numSamples);
+    }
+}
+
+const KernelTable& getTable() noexcept
+{
+    static const KernelTable table {
+        ISA::AVX2, "avx2",
+        write, vectorRead, vectorCrossfade, vectorMultiply, add, cutFilters, feedbackInput, vectorMixGain, vectorPeak,
+        sumOfSquares, vectorTruePeak, vectorMinMax, vectorVoices
+    };
+    return table;
+}
+
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    DSPKernelsAVX512.cpp
+    Created: 18 Oct 2026 11:25:51am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "DSPKernels.h"
+
+#if BROCDELAY_X86_KERNELS
+
+#include <immintrin.h>
+
+// Only AVX-512F is required
+#define DSP_KERNELS_NAMESPACE AVX512
+#if defined(_MSC_VER) && !defined(__clang__)
+ #define DSP_KERNELS_TARGET
+#else
+ #define DSP_KERNELS_TARGET __attribute__((target("avx512f")))
+#endif
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels::AVX512
+{
+
+namespace
+{
+    DSP_KERNELS_TARGET void vectorRead(const float* buffer, int bufferLength, int writeIndex,
+                                       const float* delays, float* output, int numSamples) noexcept
+    {
+        const __m512i length = _mm512_set1_epi32(bufferLength);
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i one = _mm512_set1_epi32(1);
+        const __m512i step = _mm512_set1_epi32(16);
+        __m512i position = _mm512_add_epi32(_mm512_set1_epi32(writeIndex + 1),
+                                            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                                              8, 9, 10, 11, 12, 13, 14, 15));
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            __m512 delay = _mm512_loadu_ps(delays + i);
+            __m512i integerDelay = _mm512_cvttps_epi32(delay);
+
+            __m512i readIndexA = _mm512_sub_epi32(position, integerDelay);
+            readIndexA = _mm512_mask_add_epi32(readIndexA, _mm512_cmplt_epi32_mask(readIndexA, zero), readIndexA, length);
+            __m512i readIndexB = _mm512_sub_epi32(readIndexA, one);
+            readIndexB = _mm512_mask_add_epi32(readIndexB, _mm512_cmplt_epi32_mask(readIndexB, zero), readIndexB, length);
+
+            __m512 sampleA = _mm512_i32gather_ps(readIndexA, buffer, 4);
+            __m512 sampleB = _mm512_i32gather_ps(readIndexB, buffer, 4);
+            __m512 fraction = _mm512_sub_ps(delay, _mm512_cvtepi32_ps(integerDelay));
+            _mm512_storeu_ps(output + i, _mm512_add_ps(sampleA, _mm512_mul_ps(fraction, _mm512_sub_ps(sampleB, sampleA))));
+
+            position = _mm512_add_epi32(position, step);
+        }
+        for (; i < numSamples; ++i) {
+            output[i] = readSample(buffer, bufferLength, writeIndex, delays[i], i);
+        }
+    }
+
+    DSP_KERNELS_TARGET void vectorCrossfade(float* dest, const float* other, const float* amount,
+                                            int numSamples) noexcept
+    {
+        const __m512 one = _mm512_set1_ps(1.0f);
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            __m512 x = _mm512_loadu_ps(amount + i);
+            __m512 a = _mm512_mul_ps(_mm512_sub_ps(one, x), _mm512_loadu_ps(dest + i));
+            __m512 b = _mm512_mul_ps(x, _mm512_loadu_ps(other + i));
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(a, b));
+        }
+        crossfade(dest + i, other + i, amount + i, numSamples - i);
+    }
+
+    DSP_KERNELS_TARGET void vectorMultiply(const float* source, const float* gains, float* dest,
+                                           int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            _mm512_storeu_ps(dest + i, _mm512_mul_ps(_mm512_loadu_ps(source + i), _mm512_loadu_ps(gains + i)));
+        }
+        multiply(source + i, gains + i, dest + i, numSamples - i);
+    }
+
+    DSP_KERNELS_TARGET void vectorMixGain(const float* dry, const float* wet, const float* dryGain,
+                                          const float* wetGain, const float* mix, const float* gain,
+                                          float* output, int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            __m512 d = _mm512_mul_ps(_mm512_loadu_ps(dry + i), _mm512_loadu_ps(dryGain + i));
+            __m512 w = _mm512_mul_ps(_mm512_mul_ps(_mm512_loadu_ps(wet + i), _mm512_loadu_ps(wetGain + i)),
+                                     _mm512_loadu_ps(mix + i));
+            _mm512_storeu_ps(output + i, _mm512_mul_ps(_mm512_add_ps(d, w), _mm512_loadu_ps(gain + i)));
+        }
+        mixGain(dry + i, wet + i, dryGain + i, wetGain + i, mix + i, gain + i, output + i, numSamples - i);
+    }
+
+    DSP_KERNELS_TARGET float vectorPeak(const float* data, int numSamples) noexcept
+    {
+        const __m512i absMask = _mm512_set1_epi32(0x7fffffff);
+        __m512 maxValue = _mm512_setzero_ps();
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            __m512 x = _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(_mm512_loadu_ps(data + i)), absMask));
+            maxValue = _mm512_max_ps(x, maxValue);
+        }
+
+        alignas(64) float lanes[16];
+        _mm512_store_ps(lanes, maxValue);
+        float result = peak(data + i, numSamples - i);
+        for (float lane : lanes) {
+            result = std::max(result, lane);
+        }
+        return result;
+    }
+
+    DSP_KERNELS_TARGET float vectorTruePeak(const float* data, int numSamples) noexcept
+    {
+        const __m512i absMask = _mm512_set1_epi32(0x7fffffff);
+        __m512 maxValue = _mm512_setzero_ps();
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            for (int phase = 0; phase < truePeakPhases; ++phase) {
+                __m512 sum = _mm512_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap) {
+                    __m512 product = _mm512_mul_ps(_mm512_set1_ps(truePeakCoefficients[phase][tap]),
+                                                   _mm512_loadu_ps(data + i - tap));
+                    sum = _mm512_add_ps(sum, product);
+                }
+                __m512 magnitude = _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(sum), absMask));
+                maxValue = _mm512_max_ps(magnitude, maxValue);
+            }
+        }
+
+        alignas(64) float lanes[16];
+        _mm512_store_ps(lanes, maxValue);
+        float result = truePeak(data + i, numSamples - i);
+        for (float lane : lanes) {
+            result = std::max(result, lane);
+        }
+        return result;
+    }
+
+    DSP_KERNELS_TARGET void vectorMinMax(const float* data, int numSamples, float& minValue,
+                                         float& maxValue) noexcept
+    {
+        __m512 low = _mm512_set1_ps(minValue);
+        __m512 high = _mm512_set1_ps(maxValue);
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16) {
+            __m512 x = _mm512_loadu_ps(data + i);
+            low = _mm512_min_ps(x, low);
+            high = _mm512_max_ps(x, high);
+        }
+
+        alignas(64) float lowLanes[16];
+        alignas(64) float highLanes[16];
+        _mm512_store_ps(lowLanes, low);
+        _mm512_store_ps(highLanes, high);
+        minMax(data + i, numSamples - i, minValue, maxValue);
+        for (int lane = 0; lane < 16; ++lane) {
+            minValue = std::min(minValue, lowLanes[lane]);
+            maxValue = std::max(maxValue, highLanes[lane]);
+        }
+    }
+
+    DSP_KERNELS_TARGET void vectorVoices(VoiceBatch& batch, const float* input, float* output, int numSamples) noexcept
+    {
+        // same as voices(), a vector of voices at a time
+        const int numVoices = batch.numVoices;
+        const int bufferLength = batch.bufferLength;
+        const __m512i length = _mm512_set1_epi32(bufferLength);
+        const __m512i stride = _mm512_set1_epi32(numVoices);
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i one = _mm512_set1_epi32(1);
+        const __m512i laneOffsets = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                                      8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512 delayCoeff = _mm512_set1_ps(batch.delayCoeff);
+        const __m512 R2 = _mm512_set1_ps(batch.R2);
+
+        for (int v = 0; v < numVoices; v += 16) {
+            float* lanes = batch.buffer + v;
+            __m512 delay = _mm512_loadu_ps(batch.get(voiceDelay) + v);
+            const __m512 targetDelay = _mm512_loadu_ps(batch.get(voiceTargetDelay) + v);
+            __m512 feedback = _mm512_loadu_ps(batch.get(voiceFeedback) + v);
+            const __m512 feedbackStep = _mm512_loadu_ps(batch.get(voiceFeedbackStep) + v);
+            __m512 lowCutG = _mm512_loadu_ps(batch.get(voiceLowCutG) + v);
+            const __m512 lowCutGStep = _mm512_loadu_ps(batch.get(voiceLowCutGStep) + v);
+            __m512 lowCutH = _mm512_loadu_ps(batch.get(voiceLowCutH) + v);
+            const __m512 lowCutHStep = _mm512_loadu_ps(batch.get(voiceLowCutHStep) + v);
+            __m512 highCutG = _mm512_loadu_ps(batch.get(voiceHighCutG) + v);
+            const __m512 highCutGStep = _mm512_loadu_ps(batch.get(voiceHighCutGStep) + v);
+            __m512 highCutH = _mm512_loadu_ps(batch.get(voiceHighCutH) + v);
+            const __m512 highCutHStep = _mm512_loadu_ps(batch.get(voiceHighCutHStep) + v);
+            __m512 dryGain = _mm512_loadu_ps(batch.get(voiceDryGain) + v);
+            const __m512 dryGainStep = _mm512_loadu_ps(batch.get(voiceDryGainStep) + v);
+            __m512 wetGain = _mm512_loadu_ps(batch.get(voiceWetGain) + v);
+            const __m512 wetGainStep = _mm512_loadu_ps(batch.get(voiceWetGainStep) + v);
+            __m512 lowS1 = _mm512_loadu_ps(batch.get(voiceLowCutS1) + v);
+            __m512 lowS2 = _mm512_loadu_ps(batch.get(voiceLowCutS2) + v);
+            __m512 highS1 = _mm512_loadu_ps(batch.get(voiceHighCutS1) + v);
+            __m512 highS2 = _mm512_loadu_ps(batch.get(voiceHighCutS2) + v);
+            __m512 feedbackSample = _mm512_loadu_ps(batch.get(voiceFeedbackSample) + v);
+
+            int writeIndex = batch.writeIndex;
+            for (int i = 0; i < numSamples; ++i) {
+                int next = writeIndex + 1;
+                if (next >= bufferLength) next = 0;
+
+                delay = _mm512_add_ps(delay, _mm512_mul_ps(_mm512_sub_ps(targetDelay, delay), delayCoeff));
+
+                __m512i integerDelay = _mm512_cvttps_epi32(delay);
+                __m512i readIndexA = _mm512_sub_epi32(_mm512_set1_epi32(next), integerDelay);
+                readIndexA = _mm512_mask_add_epi32(readIndexA, _mm512_cmplt_epi32_mask(readIndexA, zero), readIndexA, length);
+                __m512i readIndexB = _mm512_sub_epi32(readIndexA, one);
+                readIndexB = _mm512_mask_add_epi32(readIndexB, _mm512_cmplt_epi32_mask(readIndexB, zero), readIndexB, length);
+
+                __m512 sampleA = _mm512_i32gather_ps(_mm512_add_epi32(_mm512_mullo_epi32(readIndexA, stride), laneOffsets), lanes, 4);
+                __m512 sampleB = _mm512_i32gather_ps(_mm512_add_epi32(_mm512_mullo_epi32(readIndexB, stride), laneOffsets), lanes, 4);
+                __m512 fraction = _mm512_sub_ps(delay, _mm512_cvtepi32_ps(integerDelay));
+                __m512 wet = _mm512_add_ps(sampleA, _mm512_mul_ps(fraction, _mm512_sub_ps(sampleB, sampleA)));
+
+                __m512 g = lowCutG;
+                __m512 yHP = _mm512_mul_ps(lowCutH, _mm512_sub_ps(_mm512_sub_ps(wet, _mm512_mul_ps(lowS1, _mm512_add_ps(g, R2))), lowS2));
+                __m512 yBP = _mm512_add_ps(_mm512_mul_ps(yHP, g), lowS1);
+                lowS1 = _mm512_add_ps(_mm512_mul_ps(yHP, g), yBP);
+                __m512 yLP = _mm512_add_ps(_mm512_mul_ps(yBP, g), lowS2);
+                lowS2 = _mm512_add_ps(_mm512_mul_ps(yBP, g), yLP);
+
+                g = highCutG;
+                __m512 hp = _mm512_mul_ps(highCutH, _mm512_sub_ps(_mm512_sub_ps(yHP, _mm512_mul_ps(highS1, _mm512_add_ps(g, R2))), highS2));
+                __m512 bp = _mm512_add_ps(_mm512_mul_ps(hp, g), highS1);
+                highS1 = _mm512_add_ps(_mm512_mul_ps(hp, g), bp);
+                __m512 lp = _mm512_add_ps(_mm512_mul_ps(bp, g), highS2);
+                highS2 = _mm512_add_ps(_mm512_mul_ps(bp, g), lp);
+
+                __m512 x = _mm512_loadu_ps(input + i * numVoices + v);
+                _mm512_storeu_ps(lanes + next * numVoices, _mm512_add_ps(x, feedbackSample));
+                feedbackSample = _mm512_mul_ps(lp, feedback);
+                _mm512_storeu_ps(output + i * numVoices + v, _mm512_add_ps(_mm512_mul_ps(x, dryGain), _mm512_mul_ps(lp, wetGain)));
+
+                feedback = _mm512_add_ps(feedback, feedbackStep);
+                lowCutG = _mm512_add_ps(lowCutG, lowCutGStep);
+                lowCutH = _mm512_add_ps(lowCutH, lowCutHStep);
+                highCutG = _mm512_add_ps(highCutG, highCutGStep);
+                highCutH = _mm512_add_ps(highCutH, highCutHStep);
+                dryGain = _mm512_add_ps(dryGain, dryGainStep);
+                wetGain = _mm512_add_ps(wetGain, wetGainStep);
+                writeIndex = next;
+            }
+
+            _mm512_storeu_ps(batch.get(voiceDelay) + v, delay);
+            _mm512_storeu_ps(batch.get(voiceFeedback) + v, feedback);
+            _mm512_storeu_ps(batch.get(voiceLowCutG) + v, lowCutG);
+            _mm512_storeu_ps(batch.get(voiceLowCutH) + v, lowCutH);
+            _mm512_storeu_ps(batch.get(voiceHighCutG) + v, highCutG);
+            _mm512_storeu_ps(batch.get(voiceHighCutH) + v, highCutH);
+            _mm512_storeu_ps(batch.get(voiceDryGain) + v, dryGain);
+            _mm512_storeu_ps(batch.get(voiceWetGain) + v, wetGain);
+            _mm512_storeu_ps(batch.get(voiceLowCutS1) + v, lowS1);
+            _mm512_storeu_ps(batch.get(voiceLowCutS2) + v, lowS2);
+            _mm512_storeu_ps(batch.get(voiceHighCutS1) + v, highS1);
+            _mm512_storeu_ps(batch.get(voiceHighCutS2) + v, highS2);
+            _mm512_storeu_ps(batch.get(voiceFeedbackSample) + v, feedbackSample);
+        }
+        batch.writeIndex = advanceWriteIndex(batch.writeIndex, batch.bufferLength, numSamples);
+    }
+}
+
+const KernelTable& getTable() noexcept
+{
+    static const KernelTable table {
+        ISA::AVX512, "avx512",
+        write, vectorRead, vectorCrossfade, vectorMultiply, add, cutFilters, feedbackInput, vectorMixGain, vectorPeak,
+        sumOfSquares, vectorTruePeak, vectorMinMax, vectorVoices
+    };
+    return table;
+}
+
+}
+
+#endif
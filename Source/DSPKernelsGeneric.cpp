@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    DSPKernelsGeneric.cpp
+    Created: 18 Oct 2026 10:48:05am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Whatever the compiler's baseline target is (this is also the only table on ARM)
+
+#define DSP_KERNELS_NAMESPACE Generic
+#define DSP_KERNELS_TARGET
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels::Generic
+{
+
+const KernelTable& getTable() noexcept
+{
+    static const KernelTable table {
+        ISA::GENERIC, "generic",
+        write, read, crossfade, multiply, add, cutFilters, feedbackInput, mixGain, peak,
+        sumOfSquares, truePeak, minMax, voices
+    };
+    return table;
+}
+
+}
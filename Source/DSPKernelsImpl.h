@@ -0,0 +1,317 @@
+/*
+  ==============================================================================
+
+    DSPKernelsImpl.h
+    Created: 18 Oct 2026 10:31:47am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Plain C++ versions of the kernels. Every DSPKernels*.cpp file includes this once after
+// defining DSP_KERNELS_NAMESPACE (so each instruction set gets its own copies of these
+// functions) and DSP_KERNELS_TARGET (so the compiler may vectorize them for that set).
+
+#include <algorithm>
+#include <cmath>
+#include "DSPKernels.h"
+
+#if !defined(DSP_KERNELS_NAMESPACE) || !defined(DSP_KERNELS_TARGET)
+ #error "Define DSP_KERNELS_NAMESPACE and DSP_KERNELS_TARGET before including DSPKernelsImpl.h"
+#endif
+
+// Some targets (AVX-512 among them) imply FMA. Contracting a * b + c would round differently
+// from the generic kernels, so it is switched off for everything defined after this point.
+#if defined(__clang__)
+ #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+ #pragma GCC optimize ("fp-contract=off")
+#endif
+
+namespace DSPKernels::DSP_KERNELS_NAMESPACE
+{
+    DSP_KERNELS_TARGET inline void write(float* buffer, int bufferLength, int& writeIndex,
+                                         const float* input, int numSamples) noexcept
+    {
+        while (numSamples > 0) {
+            int start = writeIndex + 1;
+            if (start >= bufferLength) {
+                start = 0;
+            }
+
+            int count = std::min(numSamples, bufferLength - start);
+            std::copy(input, input + count, buffer + start);
+
+            writeIndex = start + count - 1;
+            input += count;
+            numSamples -= count;
+        }
+    }
+
+    DSP_KERNELS_TARGET inline float readSample(const float* buffer, int bufferLength, int writeIndex,
+                                               float delayInSamples, int sample) noexcept
+    {
+        int integerDelay = int(delayInSamples);
+
+        int readIndexA = writeIndex + 1 + sample - integerDelay;
+        if (readIndexA < 0) readIndexA += bufferLength;
+
+        int readIndexB = readIndexA - 1;
+        if (readIndexB < 0) readIndexB += bufferLength;
+
+        float sampleA = buffer[readIndexA];
+        float sampleB = buffer[readIndexB];
+
+        float fraction = delayInSamples - float(integerDelay);
+        return sampleA + fraction * (sampleB - sampleA);
+    }
+
+    DSP_KERNELS_TARGET inline void read(const float* buffer, int bufferLength, int writeIndex,
+                                        const float* delays, float* output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = readSample(buffer, bufferLength, writeIndex, delays[i], i);
+        }
+    }
+
+    DSP_KERNELS_TARGET inline void crossfade(float* dest, const float* other, const float* amount,
+                                             int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            dest[i] = (1.0f - amount[i]) * dest[i] + amount[i] * other[i];
+        }
+    }
+
+    DSP_KERNELS_TARGET inline void multiply(const float* source, const float* gains, float* dest,
+                                            int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            dest[i] = source[i] * gains[i];
+        }
+    }
+
+    DSP_KERNELS_TARGET inline void add(const float* a, const float* b, float* dest, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            dest[i] = a[i] + b[i];
+        }
+    }
+
+    DSP_KERNELS_TARGET inline void cutFilters(float* data, int numSamples, const CutFilterCoefficients& coeffs,
+                                              CutFilterState& state) noexcept
+    {
+        // The recursion runs along time, so there is nothing to vectorize here; keeping the state
+        // in registers for the whole block is what makes this faster than per-sample calls.
+        float R2 = coeffs.R2;
+        float lowS1 = state.lowCutS1;
+        float lowS2 = state.lowCutS2;
+        float highS1 = state.highCutS1;
+        float highS2 = state.highCutS2;
+
+        for (int i = 0; i < numSamples; ++i) {
+            float g = coeffs.lowCutG[i];
+            float yHP = coeffs.lowCutH[i] * (data[i] - lowS1 * (g + R2) - lowS2);
+            float yBP = yHP * g + lowS1;
+            lowS1 = yHP * g + yBP;
+            float yLP = yBP * g + lowS2;
+            lowS2 = yBP * g + yLP;
+
+            g = coeffs.highCutG[i];
+            float hp = coeffs.highCutH[i] * (yHP - highS1 * (g + R2) - highS2);
+            float bp = hp * g + highS1;
+            highS1 = hp * g + bp;
+            float lp = bp * g + highS2;
+            highS2 = bp * g + lp;
+
+            data[i] = lp;
+        }
+
+        state.lowCutS1 = lowS1;
+        state.lowCutS2 = lowS2;
+        state.highCutS1 = highS1;
+        state.highCutS2 = highS2;
+    }
+
+    DSP_KERNELS_TARGET inline void feedbackInput(const float* dryL, const float* dryR,
+                                                 const float* feedbackL, const float* feedbackR,
+                                                 const float* invert, float* outputL, float* outputR,
+                                                 int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            float keep = 1.0f - invert[i];
+            float fbInL = feedbackL[i] * keep + feedbackR[i] * invert[i];
+            float fbInR = feedbackR[i] * keep + feedbackL[i] * invert[i];
+            float dryInL = dryL[i] * keep + dryR[i] * invert[i];
+            float dryInR = dryR[i] * keep + dryL[i] * invert[i];
+            outputL[i] = dryInL + fbInL;
+            outputR[i] = dryInR + fbInR;
+        }
+    }
+
+    DSP_KERNELS_TARGET inline void mixGain(const float* dry, const float* wet,
+                                           const float* dryGain, const float* wetGain,
+                                           const float* mix, const float* gain,
+                                           float* output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = (dry[i] * dryGain[i] + wet[i] * wetGain[i] * mix[i]) * gain[i];
+        }
+    }
+
+    DSP_KERNELS_TARGET inline float peak(const float* data, int numSamples) noexcept
+    {
+        float maxValue = 0.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            maxValue = std::max(maxValue, std::abs(data[i]));
+        }
+        return maxValue;
+    }
+
+    DSP_KERNELS_TARGET inline double sumOfSquares(const float* data, int numSamples) noexcept
+    {
+        double sum = 0.0;
+        for (int i = 0; i < numSamples; ++i) {
+            sum += double(data[i]) * double(data[i]);
+        }
+        return sum;
+    }
+
+    DSP_KERNELS_TARGET inline float truePeak(const float* data, int numSamples) noexcept
+    {
+        float maxValue = 0.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            for (int phase = 0; phase < truePeakPhases; ++phase) {
+                float sum = 0.0f;
+                for (int tap = 0; tap < truePeakTaps; ++tap) {
+                    sum += truePeakCoefficients[phase][tap] * data[i - tap];
+                }
+                maxValue = std::max(maxValue, std::abs(sum));
+            }
+        }
+        return maxValue;
+    }
+
+    DSP_KERNELS_TARGET inline void minMax(const float* data, int numSamples, float& minValue,
+                                          float& maxValue) noexcept
+    {
+        float low = minValue;
+        float high = maxValue;
+        for (int i = 0; i < numSamples; ++i) {
+            low = std::min(low, data[i]);
+            high = std::max(high, data[i]);
+        }
+        minValue = low;
+        maxValue = high;
+    }
+
+    // One voice of voices(), sample by sample. The vector versions do the same operations in the
+    // same order for a whole vector of voices at a time.
+    DSP_KERNELS_TARGET inline void voice(const VoiceBatch& batch, int v, const float* input, float* output,
+                                         int numSamples) noexcept
+    {
+        const int numVoices = batch.numVoices;
+        const int bufferLength = batch.bufferLength;
+        const float delayCoeff = batch.delayCoeff;
+        const float R2 = batch.R2;
+        float* buffer = batch.buffer;
+
+        float delay = batch.get(voiceDelay)[v];
+        const float targetDelay = batch.get(voiceTargetDelay)[v];
+        float feedback = batch.get(voiceFeedback)[v];
+        const float feedbackStep = batch.get(voiceFeedbackStep)[v];
+        float lowCutG = batch.get(voiceLowCutG)[v];
+        const float lowCutGStep = batch.get(voiceLowCutGStep)[v];
+        float lowCutH = batch.get(voiceLowCutH)[v];
+        const float lowCutHStep = batch.get(voiceLowCutHStep)[v];
+        float highCutG = batch.get(voiceHighCutG)[v];
+        const float highCutGStep = batch.get(voiceHighCutGStep)[v];
+        float highCutH = batch.get(voiceHighCutH)[v];
+        const float highCutHStep = batch.get(voiceHighCutHStep)[v];
+        float dryGain = batch.get(voiceDryGain)[v];
+        const float dryGainStep = batch.get(voiceDryGainStep)[v];
+        float wetGain = batch.get(voiceWetGain)[v];
+        const float wetGainStep = batch.get(voiceWetGainStep)[v];
+        float lowS1 = batch.get(voiceLowCutS1)[v];
+        float lowS2 = batch.get(voiceLowCutS2)[v];
+        float highS1 = batch.get(voiceHighCutS1)[v];
+        float highS2 = batch.get(voiceHighCutS2)[v];
+        float feedbackSample = batch.get(voiceFeedbackSample)[v];
+
+        int writeIndex = batch.writeIndex;
+        for (int i = 0; i < numSamples; ++i) {
+            int next = writeIndex + 1;
+            if (next >= bufferLength) next = 0;
+
+            delay = delay + (targetDelay - delay) * delayCoeff;
+
+            // read as if the frame had just been written, like DelayLine::readBlock()
+            int integerDelay = int(delay);
+            int readIndexA = next - integerDelay;
+            if (readIndexA < 0) readIndexA += bufferLength;
+            int readIndexB = readIndexA - 1;
+            if (readIndexB < 0) readIndexB += bufferLength;
+
+            float sampleA = buffer[readIndexA * numVoices + v];
+            float sampleB = buffer[readIndexB * numVoices + v];
+            float fraction = delay - float(integerDelay);
+            float wet = sampleA + fraction * (sampleB - sampleA);
+
+            float g = lowCutG;
+            float yHP = lowCutH * (wet - lowS1 * (g + R2) - lowS2);
+            float yBP = yHP * g + lowS1;
+            lowS1 = yHP * g + yBP;
+            float yLP = yBP * g + lowS2;
+            lowS2 = yBP * g + yLP;
+
+            g = highCutG;
+            float hp = highCutH * (yHP - highS1 * (g + R2) - highS2);
+            float bp = hp * g + highS1;
+            highS1 = hp * g + bp;
+            float lp = bp * g + highS2;
+            highS2 = bp * g + lp;
+
+            float x = input[i * numVoices + v];
+            buffer[next * numVoices + v] = x + feedbackSample;
+            feedbackSample = lp * feedback;
+            output[i * numVoices + v] = x * dryGain + lp * wetGain;
+
+            feedback += feedbackStep;
+            lowCutG += lowCutGStep;
+            lowCutH += lowCutHStep;
+            highCutG += highCutGStep;
+            highCutH += highCutHStep;
+            dryGain += dryGainStep;
+            wetGain += wetGainStep;
+            writeIndex = next;
+        }
+
+        batch.get(voiceDelay)[v] = delay;
+        batch.get(voiceFeedback)[v] = feedback;
+        batch.get(voiceLowCutG)[v] = lowCutG;
+        batch.get(voiceLowCutH)[v] = lowCutH;
+        batch.get(voiceHighCutG)[v] = highCutG;
+        batch.get(voiceHighCutH)[v] = highCutH;
+        batch.get(voiceDryGain)[v] = dryGain;
+        batch.get(voiceWetGain)[v] = wetGain;
+        batch.get(voiceLowCutS1)[v] = lowS1;
+        batch.get(voiceLowCutS2)[v] = lowS2;
+        batch.get(voiceHighCutS1)[v] = highS1;
+        batch.get(voiceHighCutS2)[v] = highS2;
+        batch.get(voiceFeedbackSample)[v] = feedbackSample;
+    }
+
+    // Where the write index of a batch ends up after numSamples frames
+    DSP_KERNELS_TARGET inline int advanceWriteIndex(int writeIndex, int bufferLength, int numSamples) noexcept
+    {
+        return (writeIndex + numSamples % bufferLength) % bufferLength;
+    }
+
+    DSP_KERNELS_TARGET inline void voices(VoiceBatch& batch, const float* input, float* output,
+                                          int numSamples) noexcept
+    {
+        for (int v = 0; v < batch.numVoices; ++v) {
+            voice(batch, v, input, output, numSamples);
+        }
+        batch.writeIndex = advanceWriteIndex(batch.writeIndex, batch.bufferLength, numSamples);
+    }
+}
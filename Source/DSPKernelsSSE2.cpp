@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    DSPKernelsSSE2.cpp
+    Created: 18 Oct 2026 10:52:30am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "DSPKernels.h"
+
+#if BROCDELAY_X86_KERNELS
+
+#include <immintrin.h>
+
+// SSE2 is part of the x86-64 baseline, so no target attribute is needed
+#define DSP_KERNELS_NAMESPACE SSE2
+#define DSP_KERNELS_TARGET
+#include "DSPKernelsImpl.h"
+
+namespace DSPKernels::SSE2
+{
+
+namespace
+{
+    void vectorCrossfade(float* dest, const float* other, const float* amount, int numSamples) noexcept
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            __m128 x = _mm_loadu_ps(amount + i);
+            __m128 a = _mm_mul_ps(_mm_sub_ps(one, x), _mm_loadu_ps(dest + i));
+            __m128 b = _mm_mul_ps(x, _mm_loadu_ps(other + i));
+            _mm_storeu_ps(dest + i, _mm_add_ps(a, b));
+        }
+        crossfade(dest + i, other + i, amount + i, numSamples - i);
+    }
+
+    void vectorMultiply(const float* source, const float* gains, float* dest, int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_loadu_ps(source + i), _mm_loadu_ps(gains + i)));
+        }
+        multiply(source + i, gains + i, dest + i, numSamples - i);
+    }
+
+    void vectorMixGain(const float* dry, const float* wet, const float* dryGain, const float* wetGain,
+                       const float* mix, const float* gain, float* output, int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            __m128 d = _mm_mul_ps(_mm_loadu_ps(dry + i), _mm_loadu_ps(dryGain + i));
+            __m128 w = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(wet + i), _mm_loadu_ps(wetGain + i)),
+                                  _mm_loadu_ps(mix + i));
+            _mm_storeu_ps(output + i, _mm_mul_ps(_mm_add_ps(d, w), _mm_loadu_ps(gain + i)));
+        }
+        mixGain(dry + i, wet + i, dryGain + i, wetGain + i, mix + i, gain + i, output + i, numSamples - i);
+    }
+
+    float vectorPeak(const float* data, int numSamples) noexcept
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 maxValue = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            // with a NaN in the first operand maxps returns the second, so NaNs are skipped
+            maxValue = _mm_max_ps(_mm_andnot_ps(signMask, _mm_loadu_ps(data + i)), maxValue);
+        }
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, maxValue);
+        float result = peak(data + i, numSamples - i);
+        for (float lane : lanes) {
+            result = std::max(result, lane);
+        }
+        return result;
+    }
+
+    float vectorTruePeak(const float* data, int numSamples) noexcept
+    {
+        // four output samples at a time, each summed over the taps in the same order as truePeak()
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 maxValue = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            for (int phase = 0; phase < truePeakPhases; ++phase) {
+                __m128 sum = _mm_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap) {
+                    __m128 product = _mm_mul_ps(_mm_set1_ps(truePeakCoefficients[phase][tap]),
+                                                _mm_loadu_ps(data + i - tap));
+                    sum = _mm_add_ps(sum, product);
+                }
+                maxValue = _mm_max_ps(_mm_andnot_ps(signMask, sum), maxValue);
+            }
+        }
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, maxValue);
+        float result = truePeak(data + i, numSamples - i);
+        for (float lane : lanes) {
+            result = std::max(result, lane);
+        }
+        return result;
+    }
+
+    void vectorMinMax(const float* data, int numSamples, float& minValue, float& maxValue) noexcept
+    {
+        __m128 low = _mm_set1_ps(minValue);
+        __m128 high = _mm_set1_ps(maxValue);
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4) {
+            __m128 x = _mm_loadu_ps(data + i);
+            low = _mm_min_ps(x, low);
+            high = _mm_max_ps(x, high);
+        }
+
+        alignas(16) float lowLanes[4];
+        alignas(16) float highLanes[4];
+        _mm_store_ps(lowLanes, low);
+        _mm_store_ps(highLanes, high);
+        minMax(data + i, numSamples - i, minValue, maxValue);
+        for (int lane = 0; lane < 4; ++lane) {
+            minValue = std::min(minValue, lowLanes[lane]);
+            maxValue = std::max(maxValue, highLanes[lane]);
+        }
+    }
+
+    void vectorVoices(VoiceBatch& batch, const float* input, float* output, int numSamples) noexcept
+    {
+        // same as voices(), a vector of voices at a time
+        const int numVoices = batch.numVoices;
+        const int bufferLength = batch.bufferLength;
+        const __m128i length = _mm_set1_epi32(bufferLength);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128 delayCoeff = _mm_set1_ps(batch.delayCoeff);
+        const __m128 R2 = _mm_set1_ps(batch.R2);
+
+        for (int v = 0; v < numVoices; v += 4) {
+            float* lanes = batch.buffer + v;
+            __m128 delay = _mm_loadu_ps(batch.get(voiceDelay) + v);
+            const __m128 targetDelay = _mm_loadu_ps(batch.get(voiceTargetDelay) + v);
+            __m128 feedback = _mm_loadu_ps(batch.get(voiceFeedback) + v);
+            const __m128 feedbackStep = _mm_loadu_ps(batch.get(voiceFeedbackStep) + v);
+            __m128 lowCutG = _mm_loadu_ps(batch.get(voiceLowCutG) + v);
+            const __m128 lowCutGStep = _mm_loadu_ps(batch.get(voiceLowCutGStep) + v);
+            __m128 lowCutH = _mm_loadu_ps(batch.get(voiceLowCutH) + v);
+            const __m128 lowCutHStep = _mm_loadu_ps(batch.get(voiceLowCutHStep) + v);
+            __m128 highCutG = _mm_loadu_ps(batch.get(voiceHighCutG) + v);
+            const __m128 highCutGStep = _mm_loadu_ps(batch.get(voiceHighCutGStep) + v);
+            __m128 highCutH = _mm_loadu_ps(batch.get(voiceHighCutH) + v);
+            const __m128 highCutHStep = _mm_loadu_ps(batch.get(voiceHighCutHStep) + v);
+            __m128 dryGain = _mm_loadu_ps(batch.get(voiceDryGain) + v);
+            const __m128 dryGainStep = _mm_loadu_ps(batch.get(voiceDryGainStep) + v);
+            __m128 wetGain = _mm_loadu_ps(batch.get(voiceWetGain) + v);
+            const __m128 wetGainStep = _mm_loadu_ps(batch.get(voiceWetGainStep) + v);
+            __m128 lowS1 = _mm_loadu_ps(batch.get(voiceLowCutS1) + v);
+            __m128 lowS2 = _mm_loadu_ps(batch.get(voiceLowCutS2) + v);
+            __m128 highS1 = _mm_loadu_ps(batch.get(voiceHighCutS1) + v);
+            __m128 highS2 = _mm_loadu_ps(batch.get(voiceHighCutS2) + v);
+            __m128 feedbackSample = _mm_loadu_ps(batch.get(voiceFeedbackSample) + v);
+
+            int writeIndex = batch.writeIndex;
+            for (int i = 0; i < numSamples; ++i) {
+                int next = writeIndex + 1;
+                if (next >= bufferLength) next = 0;
+
+                delay = _mm_add_ps(delay, _mm_mul_ps(_mm_sub_ps(targetDelay, delay), delayCoeff));
+
+                __m128i integerDelay = _mm_cvttps_epi32(delay);
+                __m128i readIndexA = _mm_sub_epi32(_mm_set1_epi32(next), integerDelay);
+                readIndexA = _mm_add_epi32(readIndexA, _mm_and_si128(_mm_cmpgt_epi32(zero, readIndexA), length));
+                __m128i readIndexB = _mm_sub_epi32(readIndexA, one);
+                readIndexB = _mm_add_epi32(readIndexB, _mm_and_si128(_mm_cmpgt_epi32(zero, readIndexB), length));
+
+                // no gathers (or 32 bit multiplies) in SSE2
+                alignas(16) int indexA[4];
+                alignas(16) int indexB[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(indexA), readIndexA);
+                _mm_store_si128(reinterpret_cast<__m128i*>(indexB), readIndexB);
+                __m128 sampleA = _mm_setr_ps(lanes[indexA[0] * numVoices], lanes[indexA[1] * numVoices + 1],
+                                          lanes[indexA[2] * numVoices + 2], lanes[indexA[3] * numVoices + 3]);
+                __m128 sampleB = _mm_setr_ps(lanes[indexB[0] * numVoices], lanes[indexB[1] * numVoices + 1],
+                                          lanes[indexB[2] * numVoices + 2], lanes[indexB[3] * numVoices + 3]);
+                __m128 fraction = _mm_sub_ps(delay, _mm_cvtepi32_ps(integerDelay));
+                __m128 wet = _mm_add_ps(sampleA, _mm_mul_ps(fraction, _mm_sub_ps(sampleB, sampleA)));
+
+                __m128 g = lowCutG;
+                __m128 yHP = _mm_mul_ps(lowCutH, _mm_sub_ps(_mm_sub_ps(wet, _mm_mul_ps(lowS1, _mm_add_ps(g, R2))), lowS2));
+                __m128 yBP = _mm_add_ps(_mm_mul_ps(yHP, g), lowS1);
+                lowS1 = _mm_add_ps(_mm_mul_ps(yHP, g), yBP);
+                __m128 yLP = _mm_add_ps(_mm_mul_ps(yBP, g), lowS2);
+                lowS2 = _mm_add_ps(_mm_mul_ps(yBP, g), yLP);
+
+                g = highCutG;
+                __m128 hp = _mm_mul_ps(highCutH, _mm_sub_ps(_mm_sub_ps(yHP, _mm_mul_ps(highS1, _mm_add_ps(g, R2))), highS2));
+                __m128 bp = _mm_add_ps(_mm_mul_ps(hp, g), highS1);
+                highS1 = _mm_add_ps(_mm_mul_ps(hp, g), bp);
+                __m128 lp = _mm_add_ps(_mm_mul_ps(bp, g), highS2);
+                highS2 = _mm_add_ps(_mm_mul_ps(bp, g), lp);
+
+                __m128 x = _mm_loadu_ps(input + i * numVoices + v);
+                _mm_storeu_ps(lanes + next * numVoices, _mm_add_ps(x, feedbackSample));
+                feedbackSample = _mm_mul_ps(lp, feedback);
+                _mm_storeu_ps(output + i * numVoices + v, _mm_add_ps(_mm_mul_ps(x, dryGain), _mm_mul_ps(lp, wetGain)));
+
+                feedback = _mm_add_ps(feedback, feedbackStep);
+                lowCutG = _mm_add_ps(lowCutG, lowCutGStep);
+                lowCutH = _mm_add_ps(lowCutH, lowCutHStep);
+                highCutG = _mm_add_ps(highCutG, highCutGStep);
+                highCutH = _mm_add_ps(highCutH, highCutHStep);
+                dryGain = _mm_add_ps(dryGain, dryGainStep);
+                wetGain = _mm_add_ps(wetGain, wetGainStep);
+                writeIndex = next;
+            }
+
+            _mm_storeu_ps(batch.get(voiceDelay) + v, delay);
+            _mm_storeu_ps(batch.get(voiceFeedback) + v, feedback);
+            _mm_storeu_ps(batch.get(voiceLowCutG) + v, lowCutG);
+            _mm_storeu_ps(batch.get(voiceLowCutH) + v, lowCutH);
+            _mm_storeu_ps(batch.get(voiceHighCutG) + v, highCutG);
+            _mm_storeu_ps(batch.get(voiceHighCutH) + v, highCutH);
+            _mm_storeu_ps(batch.get(voiceDryGain) + v, dryGain);
+            _mm_storeu_ps(batch.get(voiceWetGain) + v, wetGain);
+            _mm_storeu_ps(batch.get(voiceLowCutS1) + v, lowS1);
+            _mm_storeu_ps(batch.get(voiceLowCutS2) + v, lowS2);
+            _mm_storeu_ps(batch.get(voiceHighCutS1) + v, highS1);
+            _mm_storeu_ps(batch.get(voiceHighCutS2) + v, highS2);
+            _mm_storeu_ps(batch.get(voiceFeedbackSample) + v, feedbackSample);
+        }
+        batch.writeIndex = advanceWriteIndex(batch.writeIndex, batch.bufferLength, numSamples);
+    }
+}
+
+const KernelTable& getTable() noexcept
+{
+    static const KernelTable table {
+        ISA::SSE2, "sse2",
+        write, read, vectorCrossfade, vectorMultiply, add, cutFilters, feedbackInput, vectorMixGain, vectorPeak,
+        sumOfSquares, vectorTruePeak, vectorMinMax, vectorVoices
+    };
+    return table;
+}
+
+}
+
+#endif
@@ -0,0 +1,790 @@
+/*
+  ==============================================================================
+
+    DelayEngine.cpp
+    Created: 19 Oct 2026 3:44:18am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <thread>
+#include "DelayEngine.h"
+#include "Trace.h"
+
+namespace
+{
+    const DelayEngine::ParameterInfo parameterInfos[DelayEngine::numParameters] =
+    {
+        { "gain",           -60.0f,                    12.0f,                     0.0f,     false },
+        { "delayTime",      DelayEngine::minDelayTime, DelayEngine::maxDelayTime, 100.0f,   false },
+        { "mix",            0.0f,                      100.0f,                    50.0f,    false },
+        { "feedback",       -105.0f,                   105.0f,                    0.0f,     false },
+        { "flipFlop",       0.0f,                      1.0f,                      0.0f,     true  },
+        { "lowCut",         20.0f,                     20000.0f,                  20.0f,    false },
+        { "highCut",        20.0f,                     20000.0f,                  20000.0f, false },
+        { "accelerateMode", 0.0f,                      2.0f,                      0.0f,     true  },
+        { "decelerateMode", 0.0f,                      2.0f,                      0.0f,     true  },
+        { "tempoSync",      0.0f,                      1.0f,                      0.0f,     true  },
+        { "delayNote",      0.0f,                      15.0f,                     9.0f,     true  },
+    };
+
+    const std::array<double, 16> noteLengthMultipliers =
+    {
+        0.125,      // 0 = 1/32
+        0.5 / 3.0,  // 1 = 1/16 trip
+        0.1875,     // 2 = 1/32 dot
+        0.25,       // 3 = 1/16
+        1.0 / 3.0,  // 4 = 1/8 trip
+        0.375,      // 5 = 1/16 dot
+        0.5,        // 6 = 1/8
+        2.0 / 3.0,  // 7 = 1/4 trip
+        0.75,       // 8 = 1/8 dot
+        1.0,        // 9 = 1/4
+        4.0 / 3.0,  // 10= 1/2 trip
+        1.5,        // 11= 1/4 dot
+        2.0,        // 12= 1/2
+        8.0 / 3.0,  // 13= 1/1 trip
+        3.0,        // 14= 1/2 dot
+        4.0         // 15= 1/1
+    };
+
+    constexpr float halfPi = float(3.141592653589793238L / 2.0L);
+
+    // juce::Decibels::decibelsToGain()
+    template <typename T> T decibelsToGain(T decibels) noexcept
+    {
+        return decibels > T(-100) ? std::pow(T(10), decibels * T(0.05)) : T(0);
+    }
+
+    // juce::approximatelyEqual()
+    bool approximatelyEqual(float a, float b) noexcept
+    {
+        if (!(std::isfinite(a) && std::isfinite(b))) {
+            return a == b;
+        }
+        float diff = std::abs(a - b);
+        return diff <= std::numeric_limits<float>::min()
+            || diff <= std::numeric_limits<float>::epsilon() * std::max(std::abs(a), std::abs(b));
+    }
+}
+
+//==============================================================================
+void DelayEngine::LinearSmoother::reset(double sampleRate, double rampLengthInSeconds) noexcept
+{
+    stepsToTarget = int(std::floor(rampLengthInSeconds * sampleRate));
+    setCurrentAndTargetValue(target);
+}
+
+void DelayEngine::LinearSmoother::setCurrentAndTargetValue(float value) noexcept
+{
+    target = current = value;
+    countdown = 0;
+}
+
+void DelayEngine::LinearSmoother::setTargetValue(float value) noexcept
+{
+    if (approximatelyEqual(value, target)) {
+        return;
+    }
+    if (stepsToTarget <= 0) {
+        setCurrentAndTargetValue(value);
+        return;
+    }
+    target = value;
+    countdown = stepsToTarget;
+    step = (target - current) / float(countdown);
+}
+
+float DelayEngine::LinearSmoother::getNextValue() noexcept
+{
+    if (countdown <= 0) {
+        return target;
+    }
+    --countdown;
+    if (countdown > 0) {
+        current += step;
+    } else {
+        current = target;
+    }
+    return current;
+}
+
+//==============================================================================
+const DelayEngine::ParameterInfo& DelayEngine::getParameterInfo(int parameter) noexcept
+{
+    return parameterInfos[std::clamp(parameter, 0, numParameters - 1)];
+}
+
+int DelayEngine::findParameter(const char* id) noexcept
+{
+    for (int i = 0; id != nullptr && i < numParameters; ++i) {
+        if (std::strcmp(parameterInfos[i].id, id) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+double DelayEngine::getMillisecondsForNoteLength(int note, double bpm) noexcept
+{
+    return 60000.0 * noteLengthMultipliers[size_t(note)] / bpm;
+}
+
+double DelayEngine::getTailLengthSeconds(double delayTimeMs, double feedbackPercent) noexcept
+{
+    // The echoes repeat every delay time, each one feedback times as loud as the one before.
+    // The tail ends when they're below -96 dB. The filters only make it shorter.
+    double feedback = std::abs(feedbackPercent) * 0.01;
+    if (feedback >= 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double delayTime = std::min(delayTimeMs, double(maxDelayTime)) * 0.001;
+    double numRepeats = feedback > 0.0 ? std::log(decibelsToGain(-96.0)) / std::log(feedback) : 0.0;
+    return delayTime * (1.0 + std::ceil(numRepeats));
+}
+
+DelayEngine::DelayEngine()
+{
+    for (int i = 0; i < numParameters; ++i) {
+        parameterValues[i] = parameterInfos[i].defaultValue;
+    }
+}
+
+void DelayEngine::prepare(double sampleRate_, int maxBlockSize_)
+{
+    sampleRate = sampleRate_;
+
+    double duration = 0.02;
+    gainSmoother.reset(sampleRate, duration);
+    mixSmoother.reset(sampleRate, duration);
+    delayTimeCoeff = 1.0f - std::exp(-1.0f / (0.2f * float(sampleRate)));
+    feedbackSmoother.reset(sampleRate, duration);
+    lowCutSmoother.reset(sampleRate, duration);
+    highCutSmoother.reset(sampleRate, duration);
+    invertStereoSmoother.reset(sampleRate, duration);
+
+    double numSamples = maxDelayTime / 1000.0 * sampleRate;
+    int maxDelayInSamples = int(std::ceil(numSamples));
+    delayLineL.setMaximumDelayInSamples(maxDelayInSamples);
+    delayLineR.setMaximumDelayInSamples(maxDelayInSamples);
+
+    // one extra sample for the feedback carried over between chunks, see processDelay()
+    maxBlockSize = std::max(maxBlockSize_, 1);
+    constexpr int floatsPerLine = int(cacheLineSize / sizeof(float));
+    scratchStride = (maxBlockSize + 1 + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+    size_t scratchSize = size_t(scratchStride) * numScratchChannels;
+    scratchStorage.reset(new float[scratchSize + floatsPerLine]);
+    void* aligned = scratchStorage.get();
+    size_t space = (scratchSize + floatsPerLine) * sizeof(float);
+    scratchData = static_cast<float*>(std::align(cacheLineSize, scratchSize * sizeof(float), aligned, space));
+
+    // one worker for the right channel while the calling thread does the left,
+    // only worth having when bouncing
+    if (nonRealtime && std::thread::hardware_concurrency() > 1) {
+        if (workerPool.getNumWorkers() == 0) {
+            workerPool.start(1);
+        }
+    } else {
+        workerPool.stop();
+    }
+
+    reset();
+}
+
+void DelayEngine::release()
+{
+    workerPool.stop();
+}
+
+void DelayEngine::reset() noexcept
+{
+    values.gain = 0.0f;
+    gainSmoother.setCurrentAndTargetValue(decibelsToGain(parameterValues[gain]));
+
+    values.delayTime = 0.0f;
+    values.delayNote = 9;
+
+    values.mix = 50.0f;
+    mixSmoother.setCurrentAndTargetValue(parameterValues[mix] * 0.01f);
+
+    values.feedback = 0.0f;
+    feedbackSmoother.setCurrentAndTargetValue(parameterValues[feedback] * 0.01f);
+
+    values.invertStereo = 0.0f;
+    invertStereoSmoother.setCurrentAndTargetValue(values.invertStereo);
+
+    values.lowCut = 0.0f;
+    lowCutSmoother.setCurrentAndTargetValue(parameterValues[lowCut]);
+
+    values.highCut = 0.0f;
+    highCutSmoother.setCurrentAndTargetValue(parameterValues[highCut]);
+
+    values.accelerateMode = 0;
+    values.decelerateMode = 0;
+
+    delayLineL.reset();
+    delayLineR.reset();
+
+    feedbackL = 0.0f;
+    feedbackR = 0.0f;
+
+    // the first position after a reset is never a jump back
+    lastTimeInSamples = std::numeric_limits<int64_t>::min();
+    loopDuck = false;
+
+    filterStateL = {};
+    filterStateR = {};
+    cutFilterR2 = DSPKernels::cutFilterR2();
+
+    lastLowCut = -1.0f;
+    lastHighCut = -1.0f;
+
+    lastMix = -1.0f;
+    dryGain = 1.0f;
+    wetGain = 0.0f;
+
+    delayInSamples = 0.0f;
+    targetDelay = 0.0f;
+
+    xfade = 0.0f;
+    xfadeInc = static_cast<float>(1.0 / (0.05 * sampleRate)); //50ms
+
+    duckFade = 1.0f;
+    duckFadeTarget = 1.0f;
+    duckCoeff = 1.0f - std::exp(-1.0f / (0.05f * float(sampleRate)));
+    duckWait = 0.0f;
+    duckWaitInc = 1.0f / (0.05f * float(sampleRate)); // 50ms
+
+    tempoSyncCoeff = 1.0f - std::exp(-1.0f / (0.2f * float(sampleRate)));
+
+    if (scratchData != nullptr) {
+        std::fill(scratchData, scratchData + size_t(scratchStride) * numScratchChannels, 0.0f);
+    }
+}
+
+void DelayEngine::setParameter(int parameter, float value) noexcept
+{
+    if (parameter < 0 || parameter >= numParameters || std::isnan(value)) {
+        return;
+    }
+    const auto& info = parameterInfos[parameter];
+    value = std::clamp(value, info.minimum, info.maximum);
+    parameterValues[parameter] = info.isInteger ? std::round(value) : value;
+}
+
+float DelayEngine::getParameter(int parameter) const noexcept
+{
+    return parameterValues[std::clamp(parameter, 0, numParameters - 1)];
+}
+
+void DelayEngine::setTempo(double bpm_) noexcept
+{
+    if (bpm_ > 0.0) {
+        bpm = bpm_;
+    }
+}
+
+void DelayEngine::setHasPosition(bool hasPosition_) noexcept
+{
+    hasPosition = hasPosition_;
+}
+
+void DelayEngine::setTimeInSamples(int64_t timeInSamples_) noexcept
+{
+    timeInSamples = timeInSamples_;
+}
+
+void DelayEngine::setNonRealtime(bool nonRealtime_) noexcept
+{
+    nonRealtime = nonRealtime_;
+}
+
+double DelayEngine::getTailLengthSeconds() const noexcept
+{
+    double delayTimeMs = parameterValues[tempoSync] != 0.0f
+        ? getMillisecondsForNoteLength(int(parameterValues[delayNote]), bpm)
+        : double(parameterValues[delayTime]);
+    return getTailLengthSeconds(delayTimeMs, parameterValues[feedback]);
+}
+
+const float* DelayEngine::getWet(int channel) const noexcept
+{
+    return getScratch(channel == 0 ? scratchWetL : scratchWetR);
+}
+
+const float* DelayEngine::getDelays() const noexcept
+{
+    return getScratch(scratchDelay);
+}
+
+const float* DelayEngine::getTargetDelays() const noexcept
+{
+    return getScratch(scratchTargetDelay);
+}
+
+//==============================================================================
+void DelayEngine::updateParameters() noexcept
+{
+    BROCDELAY_TRACE_SCOPE("DelayEngine::updateParameters");
+
+    gainSmoother.setTargetValue(decibelsToGain(parameterValues[gain]));
+
+    targetDelayTime = parameterValues[delayTime];
+    if (values.delayTime == 0.0f) {
+        values.delayTime = targetDelayTime;
+    }
+
+    values.accelerateMode = int(parameterValues[accelerateMode]);
+    values.decelerateMode = int(parameterValues[decelerateMode]);
+
+    mixSmoother.setTargetValue(parameterValues[mix] * 0.01f);
+
+    feedbackSmoother.setTargetValue(parameterValues[feedback] * 0.01f);
+
+    lowCutSmoother.setTargetValue(parameterValues[lowCut]);
+    highCutSmoother.setTargetValue(parameterValues[highCut]);
+
+    invertStereoSmoother.setTargetValue(parameterValues[flipFlop] != 0.0f ? 1.0f : 0.0f);
+
+    values.delayNote = int(parameterValues[delayNote]);
+    values.tempoSync = parameterValues[tempoSync] != 0.0f;
+}
+
+void DelayEngine::smoothen() noexcept
+{
+    values.gain = gainSmoother.getNextValue();
+
+    values.delayTime = getSmoothenedDelayTime();
+
+    values.mix = mixSmoother.getNextValue();
+
+    values.feedback = feedbackSmoother.getNextValue();
+
+    values.lowCut = lowCutSmoother.getNextValue();
+    values.highCut = highCutSmoother.getNextValue();
+
+    values.invertStereo = invertStereoSmoother.getNextValue();
+}
+
+float DelayEngine::getSmoothenedDelayTime() noexcept
+{
+    updateShiftMode();
+    if (shiftMode == ShiftMode::REPITCH && !loopDuck) {
+        return values.delayTime + (targetDelayTime - values.delayTime) * delayTimeCoeff;
+    } else {
+        return values.delayTime = targetDelayTime;
+    }
+}
+
+ShiftMode DelayEngine::determineShiftMode() noexcept
+{
+    // when looping, minimize unexpected artifacts by temporarily switching to duck mode
+    return loopDuck ? ShiftMode::DUCK : shiftMode;
+}
+
+void DelayEngine::updateLoopDuck() noexcept
+{
+    // Called once per block. The transport only ever jumps back when the host loops or seeks;
+    // blocks of the same host block all get the same position, which doesn't count.
+    if (hasPosition) {
+        if (timeInSamples < lastTimeInSamples) {
+            loopDuck = true;
+            BROCDELAY_TRACE_INSTANT("loop, switching to DUCK");
+        }
+        lastTimeInSamples = timeInSamples;
+    }
+}
+
+void DelayEngine::endLoopDuck() noexcept
+{
+    // back to the real shift mode once the duck has faded back in (or never started, when the
+    // delay time didn't change at the loop)
+    if (loopDuck && duckWait == 0.0f && duckFadeTarget == 1.0f && duckFade >= 0.999f) {
+        loopDuck = false;
+    }
+}
+
+void DelayEngine::updateShiftMode() noexcept
+{
+    if (!values.tempoSync) {
+        if (targetDelayTime < values.delayTime) { // accelerating, get the acceleration mode
+            shiftMode = static_cast<ShiftMode>(values.accelerateMode);
+        }
+        else if (targetDelayTime > values.delayTime) { // decelerating, get the deceleration mode
+            shiftMode = static_cast<ShiftMode>(values.decelerateMode);
+        }
+    } else {
+        if (values.delayNote == lastDelayNote) {
+            return;
+        } else {
+            bool isFaster = values.delayNote < lastDelayNote;
+            lastDelayNote = values.delayNote;
+            shiftMode = static_cast<ShiftMode>(isFaster ? values.accelerateMode : values.decelerateMode);
+        }
+    }
+
+    // no update is required: once the delay time stops moving, the mode can stay where it was set
+}
+
+//==============================================================================
+void DelayEngine::process(const float* inputL, const float* inputR, float* outputL, float* outputR,
+                          int numSamples) noexcept
+{
+    if (maxBlockSize == 0) {
+        return;  // not prepared
+    }
+    for (int offset = 0; offset < numSamples; offset += maxBlockSize) {
+        int blockSize = std::min(maxBlockSize, numSamples - offset);
+        processBlock(inputL + offset, inputR + offset, outputL + offset, outputR + offset, blockSize);
+    }
+}
+
+void DelayEngine::processBlock(const float* inputL, const float* inputR, float* outputL, float* outputR,
+                               int numSamples) noexcept
+{
+    updateParameters();
+    updateLoopDuck();
+
+    float syncedTime = float(getMillisecondsForNoteLength(values.delayNote, bpm));
+    if (syncedTime > maxDelayTime) {
+        syncedTime = maxDelayTime;
+    }
+
+    // copy the dry signal first, the output may share its memory with the input
+    float* dryL = getScratch(scratchDryL);
+    float* dryR = getScratch(scratchDryR);
+    std::copy(inputL, inputL + numSamples, dryL);
+    std::copy(inputR, inputR + numSamples, dryR);
+
+    {
+        BROCDELAY_TRACE_SCOPE("updateControlValues");
+        updateControlValues(numSamples, syncedTime);
+        endLoopDuck();
+    }
+
+    if (canProcessChannelsInParallel(numSamples)) {
+        BROCDELAY_TRACE_SCOPE("processDelay (parallel)");
+        DelayChannel channels[] = { getDelayChannel(0), getDelayChannel(1) };
+        auto task = [this, &channels, numSamples] (int channel) {
+            processDelayChannel(channels[channel], numSamples);
+        };
+        workerPool.run(2, task);
+    } else {
+        BROCDELAY_TRACE_SCOPE("processDelay");
+        processDelay(numSamples);
+    }
+
+    BROCDELAY_TRACE_SCOPE("mix");
+
+    const auto& kernels = DSPKernels::get();
+    const float* dryGains = getScratch(scratchDryGain);
+    const float* wetGains = getScratch(scratchWetGain);
+    const float* mixes = getScratch(scratchMix);
+    const float* gains = getScratch(scratchGain);
+
+    kernels.mixGain(dryL, getScratch(scratchWetL), dryGains, wetGains, mixes, gains, outputL, numSamples);
+    kernels.mixGain(dryR, getScratch(scratchWetR), dryGains, wetGains, mixes, gains, outputR, numSamples);
+}
+
+void DelayEngine::updateControlValues(int numSamples, float syncedTime) noexcept
+{
+    float* delays = getScratch(scratchDelay);
+    float* targetDelays = getScratch(scratchTargetDelay);
+    float* xfades = getScratch(scratchXfade);
+    float* ducks = getScratch(scratchDuck);
+    float* invertStereo = getScratch(scratchInvertStereo);
+    float* feedbacks = getScratch(scratchFeedback);
+    float* lowCutGs = getScratch(scratchLowCutG);
+    float* lowCutHs = getScratch(scratchLowCutH);
+    float* highCutGs = getScratch(scratchHighCutG);
+    float* highCutHs = getScratch(scratchHighCutH);
+    float* dryGains = getScratch(scratchDryGain);
+    float* wetGains = getScratch(scratchWetGain);
+    float* mixes = getScratch(scratchMix);
+    float* gains = getScratch(scratchGain);
+
+    float rate = float(sampleRate);
+
+    blockHasXfade = false;
+    blockHasDuck = false;
+    blockHasInvertStereo = false;
+
+    for (int sample = 0; sample < numSamples; ++sample) {
+
+        smoothen();
+        ShiftMode mode = determineShiftMode();
+
+        if (mode == ShiftMode::FADE) {
+            if (xfade == 0.0f) {
+                float delayTime = values.tempoSync ? syncedTime : values.delayTime;
+                targetDelay = (delayTime / 1000.0f) * rate;
+                if (delayInSamples == 0.0f) {
+                    delayInSamples = targetDelay;
+                } else if (targetDelay != delayInSamples) {
+                    xfade = xfadeInc;
+                    BROCDELAY_TRACE_INSTANT("FADE crossfade start");
+                }
+            }
+        } else if (mode == ShiftMode::DUCK) {
+            float delayTime = values.tempoSync ? syncedTime : values.delayTime;
+            float newTargetDelay = (delayTime / 1000.0f) * rate;
+            if (newTargetDelay != targetDelay) {
+                targetDelay = newTargetDelay;
+                if (delayInSamples == 0.0f) {
+                    delayInSamples = targetDelay; // first time
+                }
+                else {
+                    duckWait = duckWaitInc; // start counter
+                    duckFadeTarget = 0.0f; // fade out
+                    BROCDELAY_TRACE_INSTANT("DUCK fade out");
+                }
+            }
+        } else {
+            float newTargetDelayMs = values.tempoSync ? syncedTime : values.delayTime;
+            float newTargetDelay = (newTargetDelayMs / 1000.0f) * rate;
+
+            if (values.tempoSync) {
+
+                if (targetDelay != newTargetDelay) {
+                    targetDelay = newTargetDelay;
+                }
+
+                if (delayInSamples == 0.0f) {
+                    delayInSamples = targetDelay; // first-time setup
+                } else {
+                    // Always smooth toward targetDelay every sample
+                    delayInSamples = (1.0f - tempoSyncCoeff) * delayInSamples + tempoSyncCoeff * targetDelay;
+                }
+            } else {
+                delayInSamples = newTargetDelay;
+                targetDelay = newTargetDelay; // keep them in sync for next time
+            }
+        }
+
+        if (values.lowCut != lastLowCut) {
+            DSPKernels::cutFilterCoefficients(values.lowCut, sampleRate, cutFilterR2, lowCutG, lowCutH);
+            lastLowCut = values.lowCut;
+        }
+
+        if (values.highCut != lastHighCut) {
+            DSPKernels::cutFilterCoefficients(values.highCut, sampleRate, cutFilterR2, highCutG, highCutH);
+            lastHighCut = values.highCut;
+        }
+
+        float currentMix = values.mix;
+        if (std::abs(currentMix - lastMix) > 0.001f) // small tolerance to avoid floating point jitter
+        {
+            // blend with sinusoids for equal power mixing
+            dryGain = std::cos(currentMix * halfPi);
+            wetGain = std::sin(currentMix * halfPi);
+            lastMix = currentMix;
+        }
+
+        // the delay line is read at these positions before the shift modes move them below
+        delays[sample] = delayInSamples;
+        targetDelays[sample] = targetDelay;
+        xfades[sample] = 0.0f;
+        ducks[sample] = 1.0f;
+
+        if (mode == ShiftMode::FADE) {
+            if (xfade > 0.0f) {
+                xfades[sample] = xfade;
+                blockHasXfade = true;
+
+                xfade += xfadeInc;
+
+                if (xfade >= 1.0f) {
+                    delayInSamples = targetDelay;
+                    xfade = 0.0f;
+                    BROCDELAY_TRACE_INSTANT("FADE crossfade end");
+                }
+            }
+        } else if (mode == ShiftMode::DUCK) {
+
+            duckFade += (duckFadeTarget - duckFade) * duckCoeff;
+
+            ducks[sample] = duckFade;
+            blockHasDuck = true;
+
+            if (duckWait > 0.0f) {
+                duckWait += duckWaitInc;
+                if (duckWait >= 1.0f) {
+                    delayInSamples = targetDelay;
+                    duckWait = 0.0f;
+                    duckFadeTarget = 1.0f;
+                    BROCDELAY_TRACE_INSTANT("DUCK fade in");
+                }
+            }
+        }
+
+        invertStereo[sample] = values.invertStereo;
+        blockHasInvertStereo = blockHasInvertStereo || values.invertStereo != 0.0f;
+        feedbacks[sample] = values.feedback;
+        lowCutGs[sample] = lowCutG;
+        lowCutHs[sample] = lowCutH;
+        highCutGs[sample] = highCutG;
+        highCutHs[sample] = highCutH;
+        dryGains[sample] = dryGain;
+        wetGains[sample] = wetGain;
+        mixes[sample] = values.mix;
+        gains[sample] = values.gain;
+    }
+}
+
+int DelayEngine::getSafeChunkLength(int start, int numSamples) const noexcept
+{
+    // Sample i of a chunk may only read what was written before the chunk started, so every
+    // delay must be at least i + 1 samples. Delays never go below minDelayTime, which keeps
+    // chunks hundreds of samples long.
+    const float* delays = getScratch(scratchDelay, start);
+    const float* targetDelays = getScratch(scratchTargetDelay, start);
+
+    int length = 0;
+    while (length < numSamples - start) {
+        float shortest = blockHasXfade ? std::min(delays[length], targetDelays[length]) : delays[length];
+        if (int(shortest) < length + 1) {
+            break;
+        }
+        ++length;
+    }
+    return std::max(length, 1);
+}
+
+void DelayEngine::processDelay(int numSamples) noexcept
+{
+    const auto& kernels = DSPKernels::get();
+
+    float* wetL = getScratch(scratchWetL);
+    float* wetR = getScratch(scratchWetR);
+    float* targetWetL = getScratch(scratchTargetWetL);
+    float* targetWetR = getScratch(scratchTargetWetR);
+    float* fbL = getScratch(scratchFeedbackL);
+    float* fbR = getScratch(scratchFeedbackR);
+    float* delayInputL = getScratch(scratchDelayInputL);
+    float* delayInputR = getScratch(scratchDelayInputR);
+
+    int start = 0;
+    while (start < numSamples) {
+        int length = getSafeChunkLength(start, numSamples);
+
+        delayLineL.readBlock(getScratch(scratchDelay, start), wetL + start, length);
+        delayLineR.readBlock(getScratch(scratchDelay, start), wetR + start, length);
+
+        if (blockHasXfade) {
+            const float* targetDelays = getScratch(scratchTargetDelay, start);
+            const float* xfades = getScratch(scratchXfade, start);
+            delayLineL.readBlock(targetDelays, targetWetL + start, length);
+            delayLineR.readBlock(targetDelays, targetWetR + start, length);
+            kernels.crossfade(wetL + start, targetWetL + start, xfades, length);
+            kernels.crossfade(wetR + start, targetWetR + start, xfades, length);
+        }
+
+        if (blockHasDuck) {
+            const float* ducks = getScratch(scratchDuck, start);
+            kernels.multiply(wetL + start, ducks, wetL + start, length);
+            kernels.multiply(wetR + start, ducks, wetR + start, length);
+        }
+
+        DSPKernels::CutFilterCoefficients coeffs {
+            getScratch(scratchLowCutG, start),
+            getScratch(scratchLowCutH, start),
+            getScratch(scratchHighCutG, start),
+            getScratch(scratchHighCutH, start),
+            cutFilterR2
+        };
+        kernels.cutFilters(wetL + start, length, coeffs, filterStateL);
+        kernels.cutFilters(wetR + start, length, coeffs, filterStateR);
+
+        // each sample is written with the feedback of the sample before it,
+        // so fbL[0] / fbR[0] hold what was left over from the previous chunk
+        const float* feedbacks = getScratch(scratchFeedback, start);
+        fbL[0] = feedbackL;
+        fbR[0] = feedbackR;
+        kernels.multiply(wetL + start, feedbacks, fbL + 1, length);
+        kernels.multiply(wetR + start, feedbacks, fbR + 1, length);
+        feedbackL = fbL[length];
+        feedbackR = fbR[length];
+
+        //push affected signals into delay line
+        kernels.feedbackInput(getScratch(scratchDryL, start), getScratch(scratchDryR, start),
+                              fbL, fbR, getScratch(scratchInvertStereo, start),
+                              delayInputL, delayInputR, length);
+        delayLineL.writeBlock(delayInputL, length);
+        delayLineR.writeBlock(delayInputR, length);
+
+        start += length;
+    }
+}
+
+DelayEngine::DelayChannel DelayEngine::getDelayChannel(int channel) noexcept
+{
+    if (channel == 0) {
+        return { &delayLineL, &filterStateL, &feedbackL, getScratch(scratchDryL),
+                 getScratch(scratchWetL), getScratch(scratchTargetWetL),
+                 getScratch(scratchFeedbackL), getScratch(scratchDelayInputL) };
+    }
+    return { &delayLineR, &filterStateR, &feedbackR, getScratch(scratchDryR),
+             getScratch(scratchWetR), getScratch(scratchTargetWetR),
+             getScratch(scratchFeedbackR), getScratch(scratchDelayInputR) };
+}
+
+bool DelayEngine::canProcessChannelsInParallel(int numSamples) const noexcept
+{
+    // flip flop feeds each channel into the other, so then they have to go together
+    return nonRealtime
+        && workerPool.getNumWorkers() > 0
+        && numSamples >= parallelBlockSizeThreshold
+        && !blockHasInvertStereo;
+}
+
+void DelayEngine::processDelayChannel(const DelayChannel& channel, int numSamples) noexcept
+{
+    // Same as processDelay() for one channel with invertStereo at 0. Runs on a worker thread,
+    // so it only touches this channel's state and reads the shared control values.
+    const auto& kernels = DSPKernels::get();
+
+    float* wet = channel.wet;
+    float* fb = channel.feedbackOut;
+
+    int start = 0;
+    while (start < numSamples) {
+        int length = getSafeChunkLength(start, numSamples);
+
+        channel.delayLine->readBlock(getScratch(scratchDelay, start), wet + start, length);
+
+        if (blockHasXfade) {
+            channel.delayLine->readBlock(getScratch(scratchTargetDelay, start), channel.targetWet + start, length);
+            kernels.crossfade(wet + start, channel.targetWet + start, getScratch(scratchXfade, start), length);
+        }
+
+        if (blockHasDuck) {
+            kernels.multiply(wet + start, getScratch(scratchDuck, start), wet + start, length);
+        }
+
+        DSPKernels::CutFilterCoefficients coeffs {
+            getScratch(scratchLowCutG, start),
+            getScratch(scratchLowCutH, start),
+            getScratch(scratchHighCutG, start),
+            getScratch(scratchHighCutH, start),
+            cutFilterR2
+        };
+        kernels.cutFilters(wet + start, length, coeffs, *channel.filterState);
+
+        fb[0] = *channel.feedback;
+        kernels.multiply(wet + start, getScratch(scratchFeedback, start), fb + 1, length);
+        *channel.feedback = fb[length];
+
+        kernels.add(channel.dry + start, fb, channel.delayInput, length);
+        channel.delayLine->writeBlock(channel.delayInput, length);
+
+        start += length;
+    }
+}
@@ -0,0 +1,320 @@
+/*
+  ==============================================================================
+
+    DelayEngine.h
+    Created: 19 Oct 2026 3:44:18am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "CacheLine.h"
+#include "DelayLine.h"
+#include "DSPKernels.h"
+#include "ShiftMode.h"
+#include "WorkerPool.h"
+
+// The block size from which offline renders process the two channels on two threads. The
+// default of 2048 is a placeholder, not a measurement: the crossover has only been looked for
+// on a single core so far, where the pool never starts. Measure it with
+// Benchmarks/ParallelChannelBenchmark.cpp on the machines that render and set it with
+// -DBROCDELAY_PARALLEL_BLOCK_SIZE=n (the CMake cache variable of the same name does that).
+#ifndef BROCDELAY_PARALLEL_BLOCK_SIZE
+ #define BROCDELAY_PARALLEL_BLOCK_SIZE 2048
+#endif
+
+// The delay itself: parameter smoothing, the shift modes, the delay lines, the cut filters in
+// the feedback path and the dry/wet mix. DelayAudioProcessor feeds it the values of its
+// parameters and the host's tempo and renders with it; the C API in BrocDelayAPI.h does the
+// same for programs that aren't plugin hosts.
+//
+// No JUCE in here, so it builds into BrocDelayCore on its own. Parameters are set in the
+// units the plugin shows (ms, %, dB, Hz) and take effect at the start of the next block.
+// Nothing is thread safe: set parameters from the thread that processes, or between blocks.
+class DelayEngine
+{
+public:
+    enum Parameter
+    {
+        gain,            // output gain in dB
+        delayTime,       // in ms, when tempo sync is off
+        mix,             // in %
+        feedback,        // in %, negative inverts the echoes
+        flipFlop,        // 0 or 1, echoes alternate between the channels
+        lowCut,          // in Hz
+        highCut,         // in Hz
+        accelerateMode,  // ShiftMode when the delay gets shorter
+        decelerateMode,  // ShiftMode when the delay gets longer
+        tempoSync,       // 0 or 1
+        delayNote,       // note length when tempo syncing, 0 (1/32) to 15 (1/1), see DelayEngine.cpp
+        numParameters
+    };
+
+    struct ParameterInfo
+    {
+        const char* id;  // the plugin's parameter ID
+        float minimum;
+        float maximum;
+        float defaultValue;
+        bool isInteger;  // switches and choices, set values are rounded
+    };
+
+    static const ParameterInfo& getParameterInfo(int parameter) noexcept;
+
+    // The parameter with this ID, or -1
+    static int findParameter(const char* id) noexcept;
+
+    static constexpr float minDelayTime = 5.0f;
+    static constexpr float maxDelayTime = 5000.f;
+
+    static double getMillisecondsForNoteLength(int note, double bpm) noexcept;
+
+    // How long the echoes take to fall below -96 dB, infinite at 100% feedback or more
+    static double getTailLengthSeconds(double delayTimeMs, double feedbackPercent) noexcept;
+
+    DelayEngine();
+
+    // Allocates for blocks of up to maxBlockSize samples and resets. Not real-time safe.
+    void prepare(double sampleRate, int maxBlockSize);
+
+    // Stops the worker thread of offline renders. Not real-time safe.
+    void release();
+
+    // Clears the delay lines and jumps the smoothed values to their targets
+    void reset() noexcept;
+
+    void setParameter(int parameter, float value) noexcept;
+    float getParameter(int parameter) const noexcept;
+
+    // The host's tempo, for tempo sync. 120 until it's set.
+    void setTempo(double bpm) noexcept;
+
+    // The host's transport at the start of the next block. When it jumps back (a loop or a
+    // seek) the shift mode is DUCK until the delay time has settled and the echoes are back.
+    // Hosts without a position leave it where it was.
+    void setHasPosition(bool hasPosition) noexcept;
+    void setTimeInSamples(int64_t timeInSamples) noexcept;
+
+    // Offline renders may process the two channels concurrently on a worker thread. The worker
+    // is started by the next prepare() if this is set then.
+    void setNonRealtime(bool nonRealtime) noexcept;
+
+    // The tail for the current parameters and tempo
+    double getTailLengthSeconds() const noexcept;
+
+    // Processes up to getMaxBlockSize() samples. inputR may be inputL (mono in) and outputR
+    // outputL (mono out), and the outputs may be the inputs.
+    void processBlock(const float* inputL, const float* inputR, float* outputL, float* outputR,
+                      int numSamples) noexcept;
+
+    // Same for any number of samples, in blocks of getMaxBlockSize()
+    void process(const float* inputL, const float* inputR, float* outputL, float* outputR,
+                 int numSamples) noexcept;
+
+    // What the last processBlock() made, for meters and displays: the wet signal of a channel
+    // and the delay (in samples) it was read at, and where a crossfade was heading
+    const float* getWet(int channel) const noexcept;
+    const float* getDelays() const noexcept;
+    const float* getTargetDelays() const noexcept;
+
+    int getMaxBlockSize() const noexcept
+    {
+        return maxBlockSize;
+    }
+
+    double getSampleRate() const noexcept
+    {
+        return sampleRate;
+    }
+
+private:
+    // juce::LinearSmoothedValue<float>, step for step
+    class LinearSmoother
+    {
+    public:
+        void reset(double sampleRate, double rampLengthInSeconds) noexcept;
+        void setCurrentAndTargetValue(float value) noexcept;
+        void setTargetValue(float value) noexcept;
+        float getNextValue() noexcept;
+
+    private:
+        float current = 0.0f;
+        float target = 0.0f;
+        float step = 0.0f;
+        int countdown = 0;
+        int stepsToTarget = 0;
+    };
+
+    // The parameters, smoothed sample by sample
+    struct Values
+    {
+        float gain = 0.0f;
+        float delayTime = 1.0f;
+        float mix = 0.5f;
+        float feedback = 0.0f;
+        float invertStereo = 0.0f;
+        float lowCut = 20.0f;
+        float highCut = 20000.0f;
+        int accelerateMode = 0;
+        int decelerateMode = 0;
+        int delayNote = 9;
+        bool tempoSync = false;
+    };
+
+    void updateParameters() noexcept;
+    void smoothen() noexcept;
+    float getSmoothenedDelayTime() noexcept;
+    void updateShiftMode() noexcept;
+    ShiftMode determineShiftMode() noexcept;
+    void updateLoopDuck() noexcept;
+    void endLoopDuck() noexcept;
+
+    void updateControlValues(int numSamples, float syncedTime) noexcept;
+    void processDelay(int numSamples) noexcept;
+    int getSafeChunkLength(int start, int numSamples) const noexcept;
+
+    // Everything one channel of the delay needs when it's rendered on its own
+    struct DelayChannel
+    {
+        DelayLine* delayLine;
+        DSPKernels::CutFilterState* filterState;
+        float* feedback;
+        const float* dry;
+        float* wet;
+        float* targetWet;
+        float* feedbackOut;
+        float* delayInput;
+    };
+
+    DelayChannel getDelayChannel(int channel) noexcept;
+    void processDelayChannel(const DelayChannel& channel, int numSamples) noexcept;
+    bool canProcessChannelsInParallel(int numSamples) const noexcept;
+
+    float parameterValues[numParameters];
+
+    Values values;
+    LinearSmoother gainSmoother;
+    float targetDelayTime = 0.0f;
+    float delayTimeCoeff = 0.0f;
+    LinearSmoother mixSmoother;
+    LinearSmoother feedbackSmoother;
+    LinearSmoother invertStereoSmoother;
+    LinearSmoother lowCutSmoother;
+    LinearSmoother highCutSmoother;
+    int lastDelayNote = 0;
+    ShiftMode shiftMode = ShiftMode::REPITCH;
+
+    double bpm = 120.0;
+    bool hasPosition = false;
+    int64_t timeInSamples = 0;
+    int64_t lastTimeInSamples = 0;
+    bool loopDuck = false;  // the transport jumped back, see updateLoopDuck()
+
+    double sampleRate = 44100.0;
+    bool nonRealtime = false;
+
+    DelayLine delayLineL, delayLineR;
+
+    // updateControlValues() first runs the parameter smoothing and shift mode logic for every
+    // sample, storing the results in these channels, and then processBlock() renders the audio
+    // with the DSPKernels.
+    enum ScratchChannel
+    {
+        scratchDryL,
+        scratchDryR,
+        scratchDelay,
+        scratchTargetDelay,
+        scratchXfade,
+        scratchDuck,
+        scratchInvertStereo,
+        scratchFeedback,
+        scratchLowCutG,
+        scratchLowCutH,
+        scratchHighCutG,
+        scratchHighCutH,
+        scratchDryGain,
+        scratchWetGain,
+        scratchMix,
+        scratchGain,
+        scratchWetL,
+        scratchWetR,
+        scratchTargetWetL,
+        scratchTargetWetR,
+        scratchFeedbackL,
+        scratchFeedbackR,
+        scratchDelayInputL,
+        scratchDelayInputR,
+        numScratchChannels
+    };
+
+    // every channel starts on a cache line
+    std::unique_ptr<float[]> scratchStorage;
+    float* scratchData = nullptr;
+    int scratchStride = 0;
+
+    float* getScratch(int channel, int offset = 0) noexcept
+    {
+        return scratchData + channel * scratchStride + offset;
+    }
+
+    const float* getScratch(int channel, int offset = 0) const noexcept
+    {
+        return scratchData + channel * scratchStride + offset;
+    }
+
+    float delayInSamples = 0.0f;
+    float targetDelay = 0.0f;
+
+    float xfade = 0.0f;
+    float xfadeInc = 0.0f;
+
+    float duckFade = 0.0f;
+    float duckFadeTarget = 0.0f;
+    float duckCoeff = 0.0f;
+    float duckWait = 0.0f;
+    float duckWaitInc = 0.0f;
+
+    float tempoSyncCoeff = 0.0f;
+
+    float cutFilterR2 = 0.0f;
+
+    float lastLowCut = -1.0f;
+    float lastHighCut = -1.0f;
+    float lowCutG = 0.0f;
+    float lowCutH = 0.0f;
+    float highCutG = 0.0f;
+    float highCutH = 0.0f;
+
+    float lastMix = -1.0f;
+    float dryGain = 1.0f;
+    float wetGain = 0.0f;
+
+    int maxBlockSize = 0;
+
+    // whether any sample in the current block crossfades (FADE) or ducks (DUCK)
+    bool blockHasXfade = false;
+    bool blockHasDuck = false;
+
+    // whether flip flop mixes the channels anywhere in the current block
+    bool blockHasInvertStereo = false;
+
+    // offline renders write the two channels from two threads at once, so each gets its own
+    // cache line
+    alignas(cacheLineSize) DSPKernels::CutFilterState filterStateL;
+    float feedbackL = 0.0f;
+    alignas(cacheLineSize) DSPKernels::CutFilterState filterStateR;
+    float feedbackR = 0.0f;
+
+    // Offline renders with flip flop off process the left and right channels concurrently.
+    // Below this block size the handover should cost more than it saves; the default is a
+    // placeholder, see BROCDELAY_PARALLEL_BLOCK_SIZE.
+    static constexpr int parallelBlockSizeThreshold = BROCDELAY_PARALLEL_BLOCK_SIZE;
+    WorkerPool workerPool;
+
+    DelayEngine(const DelayEngine&) = delete;
+    DelayEngine& operator=(const DelayEngine&) = delete;
+};
@@ -1,67 +1,87 @@
-/*
-  ==============================================================================
-
-    DelayLine.cpp
-    Created: 3 Jun 2025 11:12:21pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "DelayLine.h"
-
-void DelayLine::setMaximumDelayInSamples(int maxLengthInSamples)
-{
-    jassert(maxLengthInSamples > 0);
-    
-    int paddedLength = maxLengthInSamples + 1;
-    
-    if (bufferLength < paddedLength)
-    {
-        bufferLength = paddedLength;
-        buffer.reset(new float[size_t(bufferLength)]);
-    }
-}
-
-void DelayLine::reset() noexcept
-{
-    writeIndex = bufferLength - 1;
-    
-    for (size_t i = 0; i < size_t(bufferLength); ++i) {
-        buffer[i] = 0.0f;
-    }
-}
-
-void DelayLine::write(float input) noexcept
-{
-    jassert(bufferLength > 0);
-    
-    writeIndex += 1;
-    
-    if (writeIndex >= bufferLength) {
-        writeIndex = 0;
-    }
-    
-    buffer[size_t(writeIndex)] = input;
-}
-
-float DelayLine::read(float delayInSamples) const noexcept
-{
-    jassert(delayInSamples >= 0.0f);
-    jassert(delayInSamples <= bufferLength - 1.0f);
-    
-    int integerDelay = int(delayInSamples);
-    
-    int readIndexA = writeIndex - integerDelay;
-    if (readIndexA < 0) readIndexA += bufferLength;
-    
-    int readIndexB = readIndexA - 1;
-    if (readIndexB < 0) readIndexB += bufferLength;
-    
-    float sampleA = buffer[size_t(readIndexA)];
-    float sampleB = buffer[size_t(readIndexB)];
-    
-    float fraction = delayInSamples - float(integerDelay);
-    return sampleA + fraction * (sampleB - sampleA);
-}
+/*
+  ==============================================================================
+
+    DelayLine.cpp
+    Created: 3 Jun 2025 11:12:21pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <cassert>
+#include "DelayLine.h"
+#include "DSPKernels.h"
+
+void DelayLine::setMaximumDelayInSamples(int maxLengthInSamples)
+{
+    assert(maxLengthInSamples > 0);
+    
+    int paddedLength = maxLengthInSamples + 1;
+    
+    if (bufferLength < paddedLength)
+    {
+        bufferLength = paddedLength;
+        buffer.reset(new float[size_t(bufferLength)]);
+    }
+}
+
+void DelayLine::reset() noexcept
+{
+    writeIndex = bufferLength - 1;
+    
+    for (size_t i = 0; i < size_t(bufferLength); ++i) {
+        buffer[i] = 0.0f;
+    }
+}
+
+void DelayLine::write(float input) noexcept
+{
+    assert(bufferLength > 0);
+    
+    writeIndex += 1;
+    
+    if (writeIndex >= bufferLength) {
+        writeIndex = 0;
+    }
+    
+    buffer[size_t(writeIndex)] = input;
+}
+
+float DelayLine::read(float delayInSamples) const noexcept
+{
+    assert(delayInSamples >= 0.0f);
+    assert(delayInSamples <= bufferLength - 1.0f);
+    
+    int integerDelay = int(delayInSamples);
+    
+    int readIndexA = writeIndex - integerDelay;
+    if (readIndexA < 0) readIndexA += bufferLength;
+    
+    int readIndexB = readIndexA - 1;
+    if (readIndexB < 0) readIndexB += bufferLength;
+    
+    float sampleA = buffer[size_t(readIndexA)];
+    float sampleB = buffer[size_t(readIndexB)];
+    
+    float fraction = delayInSamples - float(integerDelay);
+    return sampleA + fraction * (sampleB - sampleA);
+}
+
+void DelayLine::writeBlock(const float* input, int numSamples) noexcept
+{
+    assert(bufferLength > 0);
+    
+    DSPKernels::get().write(buffer.get(), bufferLength, writeIndex, input, numSamples);
+}
+
+void DelayLine::readBlock(const float* delays, float* output, int numSamples) const noexcept
+{
+   #ifndef NDEBUG
+    for (int i = 0; i < numSamples; ++i) {
+        assert(delays[i] >= float(i + 1));
+        assert(delays[i] <= bufferLength - 1.0f);
+    }
+   #endif
+    
+    DSPKernels::get().read(buffer.get(), bufferLength, writeIndex, delays, output, numSamples);
+}
@@ -1,33 +1,40 @@
-/*
-  ==============================================================================
-
-    DelayLine.h
-    Created: 3 Jun 2025 11:12:21pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <memory>
-
-class DelayLine
-{
-public:
-    void setMaximumDelayInSamples(int maxLengthInSamples);
-    void reset() noexcept;
-    
-    void write(float input) noexcept;
-    float read(float delayInSamples) const noexcept;
-    
-    int getBufferLength() const noexcept
-    {
-        return bufferLength;
-    }
-    
-private:
-    std::unique_ptr<float[]> buffer;
-    int bufferLength = 0;
-    int writeIndex = 0;
-};
+/*
+  ==============================================================================
+
+    DelayLine.h
+    Created: 3 Jun 2025 11:12:21pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <memory>
+
+// Uses assert() rather than jassert() so DelayLineBenchmark can build it without JUCE
+class DelayLine
+{
+public:
+    void setMaximumDelayInSamples(int maxLengthInSamples);
+    void reset() noexcept;
+    
+    void write(float input) noexcept;
+    float read(float delayInSamples) const noexcept;
+    
+    // Block versions of write() and read() that run on the dispatched DSPKernels.
+    // readBlock() reads sample i as if the block had been written up to and including that
+    // sample, so delays[i] must be at least i + 1: nothing that isn't written yet gets read.
+    void writeBlock(const float* input, int numSamples) noexcept;
+    void readBlock(const float* delays, float* output, int numSamples) const noexcept;
+    
+    int getBufferLength() const noexcept
+    {
+        return bufferLength;
+    }
+    
+private:
+    std::unique_ptr<float[]> buffer;
+    int bufferLength = 0;
+    int writeIndex = 0;
+};
@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    DelayVoiceBatch.cpp
+    Created: 19 Oct 2026 4:37:26am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include "DelayVoiceBatch.h"
+#include "Trace.h"
+
+namespace
+{
+    constexpr float halfPi = float(3.141592653589793238L / 2.0L);
+
+    float decibelsToGain(float decibels) noexcept
+    {
+        return decibels > -100.0f ? std::pow(10.0f, decibels * 0.05f) : 0.0f;
+    }
+}
+
+DelayVoiceBatch::DelayVoiceBatch(int numVoices_)
+{
+    constexpr int lanes = DSPKernels::maxVoiceLanes;
+    numVoices = (std::max(numVoices_, 1) + lanes - 1) / lanes * lanes;
+
+    size_t count = size_t(numVoices);
+    parameterValues.reset(new float[count * DelayEngine::numParameters]);
+    for (int p = 0; p < DelayEngine::numParameters; ++p) {
+        std::fill_n(parameterValues.get() + p * numVoices, count, DelayEngine::getParameterInfo(p).defaultValue);
+    }
+
+    activity.reset(new Activity[count]);
+    std::fill_n(activity.get(), count, Activity::changed);
+
+    rampCurrent.reset(new float[count * numSmoothed]());
+    rampTarget.reset(new float[count * numSmoothed]());
+    rampStep.reset(new float[count * numSmoothed]());
+    rampCountdown.reset(new int[count * numSmoothed]());
+
+    voiceStates.reset(new float[count * DSPKernels::numVoiceStates]());
+    batch.states = voiceStates.get();
+    batch.numVoices = numVoices;
+}
+
+void DelayVoiceBatch::prepare(double sampleRate_, float maxDelayTime)
+{
+    sampleRate = sampleRate_;
+    stepsToTarget = int(std::floor(0.02 * sampleRate));
+
+    maxDelayTime = std::clamp(maxDelayTime, DelayEngine::minDelayTime, DelayEngine::maxDelayTime);
+    int maxDelay = int(std::ceil(maxDelayTime / 1000.0 * sampleRate));
+    maxDelayInSamples = float(maxDelay);
+
+    // the kernel indexes the delay lines of all voices with 32 bit ints
+    int bufferLength = maxDelay + 1;
+    if (bufferLength > INT_MAX / numVoices) {
+        throw std::length_error("DelayVoiceBatch: too many voices for this delay time");
+    }
+
+    if (batch.bufferLength != bufferLength) {
+        delayBuffer.reset();
+        batch.buffer = nullptr;
+        delayBuffer.reset(new float[size_t(bufferLength) * size_t(numVoices)]);
+        batch.buffer = delayBuffer.get();
+        batch.bufferLength = bufferLength;
+    }
+
+    batch.delayCoeff = 1.0f - std::exp(-1.0f / (0.2f * float(sampleRate)));
+    batch.R2 = DSPKernels::cutFilterR2();
+
+    reset();
+}
+
+void DelayVoiceBatch::reset() noexcept
+{
+    if (!isPrepared()) {
+        return;
+    }
+
+    std::fill_n(delayBuffer.get(), size_t(batch.bufferLength) * size_t(numVoices), 0.0f);
+    std::fill_n(voiceStates.get(), size_t(numVoices) * DSPKernels::numVoiceStates, 0.0f);
+    batch.writeIndex = batch.bufferLength - 1;
+
+    for (int v = 0; v < numVoices; ++v) {
+        updateTargets(v);
+        for (int s = 0; s < numSmoothed; ++s) {
+            size_t i = size_t(s * numVoices + v);
+            rampCurrent[i] = rampTarget[i];
+            rampCountdown[i] = 0;
+        }
+        setCoefficients(v, 0);
+        batch.get(DSPKernels::voiceDelay)[v] = batch.get(DSPKernels::voiceTargetDelay)[v];
+        activity[size_t(v)] = Activity::idle;
+    }
+}
+
+void DelayVoiceBatch::setParameter(int voice, int parameter, float value) noexcept
+{
+    if (voice < 0 || voice >= numVoices || parameter < 0 || parameter >= DelayEngine::numParameters
+            || std::isnan(value)) {
+        return;
+    }
+    const auto& info = DelayEngine::getParameterInfo(parameter);
+    value = std::clamp(value, info.minimum, info.maximum);
+    parameterValues[size_t(parameter * numVoices + voice)] = info.isInteger ? std::round(value) : value;
+    activity[size_t(voice)] = Activity::changed;
+}
+
+void DelayVoiceBatch::setParameter(int parameter, float value) noexcept
+{
+    for (int v = 0; v < numVoices; ++v) {
+        setParameter(v, parameter, value);
+    }
+}
+
+float DelayVoiceBatch::getParameter(int voice, int parameter) const noexcept
+{
+    if (voice < 0 || voice >= numVoices || parameter < 0 || parameter >= DelayEngine::numParameters) {
+        return 0.0f;
+    }
+    return getValue(parameter, voice);
+}
+
+void DelayVoiceBatch::setTempo(double bpm_) noexcept
+{
+    if (bpm_ <= 0.0 || bpm_ == bpm) {
+        return;
+    }
+    bpm = bpm_;
+    for (int v = 0; v < numVoices; ++v) {
+        if (getValue(DelayEngine::tempoSync, v) != 0.0f) {
+            activity[size_t(v)] = Activity::changed;
+        }
+    }
+}
+
+void DelayVoiceBatch::process(const float* input, float* output, int numSamples) noexcept
+{
+    if (!isPrepared()) {
+        return;
+    }
+
+    const auto& kernels = DSPKernels::get();
+    size_t frameSize = size_t(numVoices);
+
+    for (int offset = 0; offset < numSamples; offset += controlBlockSize) {
+        int blockSize = std::min(controlBlockSize, numSamples - offset);
+        {
+            BROCDELAY_TRACE_SCOPE("DelayVoiceBatch::updateControls");
+            updateControls(blockSize);
+        }
+        BROCDELAY_TRACE_SCOPE("DelayVoiceBatch::voices");
+        kernels.voices(batch, input + size_t(offset) * frameSize, output + size_t(offset) * frameSize, blockSize);
+    }
+}
+
+//==============================================================================
+void DelayVoiceBatch::updateControls(int numSamples) noexcept
+{
+    for (int v = 0; v < numVoices; ++v) {
+        switch (activity[size_t(v)]) {
+            case Activity::idle:
+                break;
+
+            case Activity::changed:
+                updateTargets(v);
+                [[fallthrough]];
+
+            case Activity::ramping:
+                // the coefficients head for where the smoothed values are at the end of the block
+                if (!advanceRamps(v, numSamples)) {
+                    activity[size_t(v)] = Activity::settling;
+                } else {
+                    activity[size_t(v)] = Activity::ramping;
+                }
+                setCoefficients(v, numSamples);
+                break;
+
+            case Activity::settling:
+                setCoefficients(v, 0);
+                activity[size_t(v)] = Activity::idle;
+                break;
+        }
+    }
+}
+
+void DelayVoiceBatch::updateTargets(int voice) noexcept
+{
+    float targets[numSmoothed];
+    targets[smoothedGain] = decibelsToGain(getValue(DelayEngine::gain, voice));
+    targets[smoothedMix] = getValue(DelayEngine::mix, voice) * 0.01f;
+    targets[smoothedFeedback] = getValue(DelayEngine::feedback, voice) * 0.01f;
+    targets[smoothedLowCut] = getValue(DelayEngine::lowCut, voice);
+    targets[smoothedHighCut] = getValue(DelayEngine::highCut, voice);
+
+    // like juce::LinearSmoothedValue::setTargetValue(), a new target restarts the ramp
+    for (int s = 0; s < numSmoothed; ++s) {
+        size_t i = size_t(s * numVoices + voice);
+        if (targets[s] == rampTarget[i]) {
+            continue;
+        }
+        rampTarget[i] = targets[s];
+        if (stepsToTarget <= 0) {
+            rampCurrent[i] = targets[s];
+            rampCountdown[i] = 0;
+        } else {
+            rampCountdown[i] = stepsToTarget;
+            rampStep[i] = (targets[s] - rampCurrent[i]) / float(stepsToTarget);
+        }
+    }
+
+    float delayTime = getValue(DelayEngine::tempoSync, voice) != 0.0f
+        ? float(DelayEngine::getMillisecondsForNoteLength(int(getValue(DelayEngine::delayNote, voice)), bpm))
+        : getValue(DelayEngine::delayTime, voice);
+    float targetDelay = (delayTime / 1000.0f) * float(sampleRate);
+    batch.get(DSPKernels::voiceTargetDelay)[voice] = std::min(targetDelay, maxDelayInSamples);
+}
+
+bool DelayVoiceBatch::advanceRamps(int voice, int numSamples) noexcept
+{
+    bool moving = false;
+    for (int s = 0; s < numSmoothed; ++s) {
+        size_t i = size_t(s * numVoices + voice);
+        if (rampCountdown[i] > numSamples) {
+            rampCurrent[i] += rampStep[i] * float(numSamples);
+            rampCountdown[i] -= numSamples;
+            moving = true;
+        } else {
+            rampCurrent[i] = rampTarget[i];
+            rampCountdown[i] = 0;
+        }
+    }
+    return moving;
+}
+
+void DelayVoiceBatch::setCoefficients(int voice, int numSamples) noexcept
+{
+    auto current = [this, voice] (int smoothed) { return rampCurrent[size_t(smoothed * numVoices + voice)]; };
+
+    float gain = current(smoothedGain);
+    float mix = current(smoothedMix);
+
+    float values[DSPKernels::numVoiceStates] {};
+    values[DSPKernels::voiceFeedback] = current(smoothedFeedback);
+    DSPKernels::cutFilterCoefficients(current(smoothedLowCut), sampleRate, batch.R2,
+                                      values[DSPKernels::voiceLowCutG], values[DSPKernels::voiceLowCutH]);
+    DSPKernels::cutFilterCoefficients(current(smoothedHighCut), sampleRate, batch.R2,
+                                      values[DSPKernels::voiceHighCutG], values[DSPKernels::voiceHighCutH]);
+
+    // equal power mixing, and like in DelayEngine the echoes are scaled by the mix once more
+    values[DSPKernels::voiceDryGain] = gain * std::cos(mix * halfPi);
+    values[DSPKernels::voiceWetGain] = gain * std::sin(mix * halfPi) * mix;
+
+    // each coefficient is followed by its step in DSPKernels::VoiceState
+    for (int state : { DSPKernels::voiceFeedback, DSPKernels::voiceLowCutG, DSPKernels::voiceLowCutH,
+                       DSPKernels::voiceHighCutG, DSPKernels::voiceHighCutH, DSPKernels::voiceDryGain,
+                       DSPKernels::voiceWetGain }) {
+        float& coefficient = batch.get(state)[voice];
+        float& step = batch.get(state + 1)[voice];
+        if (numSamples > 0) {
+            step = (values[state] - coefficient) / float(numSamples);
+        } else {
+            coefficient = values[state];
+            step = 0.0f;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    DelayVoiceBatch.h
+    Created: 19 Oct 2026 4:37:26am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "DelayEngine.h"
+#include "DSPKernels.h"
+
+// Many independent mono delays with the same shape, for rendering lots of voices at once. Every
+// voice is one lane of the DSPKernels::voices() kernel and all of its state is stored voice by
+// voice (see DSPKernels::VoiceState), so one AVX2 pass advances 8 voices and AVX-512 16.
+//
+// A voice sounds like one channel of DelayEngine: the same parameters in the same units (see
+// DelayEngine::Parameter), delay line, cut filters, feedback and mix. What doesn't apply to a
+// mono voice is left out: flip flop, and the FADE and DUCK shift modes (voices always repitch).
+// The parameters are smoothed per control block of controlBlockSize samples; the kernel ramps
+// the coefficients linearly in between.
+//
+// Audio goes in and out frame by frame: sample i of voice v is at [i * getNumVoices() + v].
+// Nothing is thread safe, like DelayEngine.
+class DelayVoiceBatch
+{
+public:
+    static constexpr int controlBlockSize = 64;
+
+    // numVoices is rounded up to a whole number of DSPKernels::maxVoiceLanes. The parameters
+    // start at their defaults.
+    explicit DelayVoiceBatch(int numVoices);
+
+    // Allocates the delay lines for delays of up to maxDelayTime ms and resets. Not real-time
+    // safe. Throws std::length_error when the delay lines of all voices are too long for the
+    // kernel to index.
+    void prepare(double sampleRate, float maxDelayTime = DelayEngine::maxDelayTime);
+
+    // Clears the delay lines and jumps the smoothed values to their targets
+    void reset() noexcept;
+
+    void setParameter(int voice, int parameter, float value) noexcept;
+    float getParameter(int voice, int parameter) const noexcept;
+
+    // The same value for every voice
+    void setParameter(int parameter, float value) noexcept;
+
+    // The tempo for the voices with tempo sync on, 120 until it's set
+    void setTempo(double bpm) noexcept;
+
+    // input and output hold numSamples frames of getNumVoices() samples and may be the same
+    void process(const float* input, float* output, int numSamples) noexcept;
+
+    int getNumVoices() const noexcept
+    {
+        return numVoices;
+    }
+
+    double getSampleRate() const noexcept
+    {
+        return sampleRate;
+    }
+
+    bool isPrepared() const noexcept
+    {
+        return delayBuffer != nullptr;
+    }
+
+private:
+    // What glides over 20 ms, like DelayEngine's smoothers: a linear ramp per voice, advanced a
+    // control block at a time. The delay time glides in the kernel itself.
+    enum Smoothed
+    {
+        smoothedGain,
+        smoothedMix,
+        smoothedFeedback,
+        smoothedLowCut,
+        smoothedHighCut,
+        numSmoothed
+    };
+
+    // Only voices that aren't idle cost anything in updateControls()
+    enum class Activity : uint8_t
+    {
+        idle,
+        changed,   // a parameter was set since the last control block
+        ramping,   // the smoothed values are moving
+        settling   // the ramps just ended, the coefficients are put exactly on their targets
+    };
+
+    void updateControls(int numSamples) noexcept;
+    void updateTargets(int voice) noexcept;
+    bool advanceRamps(int voice, int numSamples) noexcept;
+    void setCoefficients(int voice, int numSamples) noexcept;
+
+    float getValue(int parameter, int voice) const noexcept
+    {
+        return parameterValues[size_t(parameter * numVoices + voice)];
+    }
+
+    int numVoices;
+
+    std::unique_ptr<float[]> parameterValues;  // numParameters arrays of numVoices
+    std::unique_ptr<Activity[]> activity;
+
+    // numSmoothed arrays of numVoices each
+    std::unique_ptr<float[]> rampCurrent;
+    std::unique_ptr<float[]> rampTarget;
+    std::unique_ptr<float[]> rampStep;
+    std::unique_ptr<int[]> rampCountdown;
+    int stepsToTarget = 0;
+
+    double bpm = 120.0;
+    double sampleRate = 44100.0;
+    float maxDelayInSamples = 0.0f;
+
+    // the kernel's DSPKernels::VoiceState arrays and the delay lines of all voices
+    std::unique_ptr<float[]> voiceStates;
+    std::unique_ptr<float[]> delayBuffer;
+    DSPKernels::VoiceBatch batch {};
+
+    DelayVoiceBatch(const DelayVoiceBatch&) = delete;
+    DelayVoiceBatch& operator=(const DelayVoiceBatch&) = delete;
+};
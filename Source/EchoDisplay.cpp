@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    EchoDisplay.cpp
+    Created: 18 Oct 2026 9:52:40pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "EchoDisplay.h"
+#include "LookAndFeel.h"
+#include "Trace.h"
+
+//==============================================================================
+EchoDisplay::EchoDisplay(EchoQueue& echoPoints_) : echoPoints(echoPoints_)
+{
+    // whatever piled up while no editor was open is too old to show
+    echoPoints.discardAll();
+    
+    setOpaque(true);
+    refreshScheduler->add(*this, *this);
+}
+
+EchoDisplay::~EchoDisplay()
+{
+    refreshScheduler->remove(*this);
+}
+
+void EchoDisplay::paint (juce::Graphics& g)
+{
+    BROCDELAY_TRACE_SCOPE("EchoDisplay::paint");
+    
+    float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (scale != layerScale) {
+        renderWaveform(scale);
+    }
+    
+    // one image pixel to one physical pixel, whatever the scale
+    g.drawImageTransformed(waveform, juce::AffineTransform::scale(1.0f / layerScale));
+    
+    if (latest.targetDelay != latest.delay) {
+        drawTap(g, latest.targetDelay, Colors::EchoDisplay::targetTap);
+    }
+    drawTap(g, latest.delay, Colors::EchoDisplay::tap);
+}
+
+void EchoDisplay::drawTap(juce::Graphics& g, float delay, juce::Colour colour)
+{
+    // the echo of what is arriving now was this far back
+    float x = float(getWidth()) - delay * float(echoPointsPerSecond);
+    if (x >= 0.0f) {
+        g.setColour(colour);
+        g.fillRect(x, 0.0f, 1.0f, float(getHeight()));
+    }
+}
+
+void EchoDisplay::resized()
+{
+    // keep the newest points when the width changes
+    std::vector<EchoPoint> resizedHistory(size_t(std::max(getWidth(), 0)), EchoPoint { 0.0f, 0.0f, 0.0f, 0.0f });
+    size_t count = std::min(resizedHistory.size(), history.size());
+    for (size_t i = 0; i < count; ++i) {
+        size_t from = (historyStart + history.size() - count + i) % history.size();
+        resizedHistory[resizedHistory.size() - count + i] = history[from];
+    }
+    history = std::move(resizedHistory);
+    historyStart = 0;
+    
+    // drawn again by the next paint(), at the scale it paints at
+    layerScale = 0.0f;
+}
+
+void EchoDisplay::refresh([[maybe_unused]] double elapsedSeconds)
+{
+    if (history.empty()) {
+        echoPoints.discardAll();
+        return;
+    }
+    
+    int numNew = 0;
+    echoPoints.drain([&] (const EchoPoint& point) {
+        history[historyStart] = point;
+        historyStart = (historyStart + 1) % history.size();
+        latest = point;
+        ++numNew;
+    });
+    
+    if (numNew == 0) {
+        return;
+    }
+    
+    if (layerScale == 0.0f) {
+        // out of date, paint() draws it from scratch anyway
+    } else if (numNew >= int(history.size())) {
+        renderWaveform(layerScale);
+    } else {
+        // scroll what is there and draw only the new columns on the right. The shift is whole
+        // pixels, but not always the same number of them for the same number of columns.
+        int64_t previousEnd = columnsEnd;
+        columnsEnd += numNew;
+        int shift = columnEdge(columnsEnd) - columnEdge(previousEnd);
+        waveform.moveImageSection(0, 0, shift, 0, waveform.getWidth() - shift, waveform.getHeight());
+        size_t first = (historyStart + history.size() - size_t(numNew)) % history.size();
+        drawColumns(first, numNew);
+    }
+    repaint();
+}
+
+void EchoDisplay::renderWaveform(float scale)
+{
+    layerScale = scale;
+    columnsEnd = int64_t(history.size());
+    
+    int imageWidth = std::max(1, int(std::ceil(float(history.size()) * scale)));
+    int imageHeight = std::max(1, int(std::ceil(float(getHeight()) * scale)));
+    waveform = juce::Image(juce::Image::RGB, imageWidth, imageHeight, true);
+    
+    // the oldest column may start a pixel in from the left edge
+    juce::Graphics(waveform).fillAll(Colors::EchoDisplay::background);
+    
+    drawColumns(historyStart, int(history.size()));
+}
+
+int EchoDisplay::columnEdge(int64_t column) const
+{
+    return int(std::floor(double(column) * double(layerScale)));
+}
+
+void EchoDisplay::drawColumns(size_t first, int count)
+{
+    if (history.empty()) {
+        return;
+    }
+    
+    juce::Graphics g(waveform);
+    
+    int height = waveform.getHeight();
+    float centre = float(height) * 0.5f;
+    
+    // The newest column ends at the right edge. Column edges sit at whole multiples of the
+    // scale counted from the start of the scrolling, so every column keeps its pixels as it
+    // moves left, even when the scale isn't a whole number.
+    int right = waveform.getWidth();
+    int endEdge = columnEdge(columnsEnd);
+    auto columnX = [&] (int64_t column) { return right - (endEdge - columnEdge(column)); };
+    
+    int64_t firstColumn = columnsEnd - int64_t(history.size())
+                        + int64_t((first + history.size() - historyStart) % history.size());
+    int x = columnX(firstColumn);
+    int width = columnX(firstColumn + count) - x;
+    
+    g.setColour(Colors::EchoDisplay::background);
+    g.fillRect(x, 0, width, height);
+    
+    g.setColour(Colors::EchoDisplay::centreLine);
+    g.fillRect(x, juce::roundToInt(centre), width, 1);
+    
+    g.setColour(Colors::EchoDisplay::waveform);
+    for (int i = 0; i < count; ++i) {
+        const auto& point = history[(first + size_t(i)) % history.size()];
+        if (!(point.min <= point.max)) {
+            continue;  // nothing but NaNs
+        }
+        int left = columnX(firstColumn + i);
+        int top = juce::roundToInt(centre - juce::jlimit(-1.0f, 1.0f, point.max) * centre);
+        int bottom = juce::roundToInt(centre - juce::jlimit(-1.0f, 1.0f, point.min) * centre);
+        g.fillRect(left, top, columnX(firstColumn + i + 1) - left, std::max(1, bottom - top));
+    }
+}
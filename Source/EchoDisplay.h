@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    EchoDisplay.h
+    Created: 18 Oct 2026 9:52:40pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EchoPoints.h"
+#include "RefreshScheduler.h"
+
+//==============================================================================
+/*
+    Scrolling picture of the wet signal, one EchoPoint per logical pixel with the newest on
+    the right, and markers where the delay is reading (and heading, while it shifts).
+*/
+class EchoDisplay  : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    // The display is the only reader of the queue
+    explicit EchoDisplay(EchoQueue& echoPoints);
+    ~EchoDisplay() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    void refresh(double elapsedSeconds) override;
+    
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;
+    
+    EchoQueue& echoPoints;
+    
+    // The last getWidth() points, oldest at historyStart
+    std::vector<EchoPoint> history;
+    size_t historyStart = 0;
+    
+    EchoPoint latest { 0.0f, 0.0f, 0.0f, 0.0f };
+    
+    // The waveform in physical pixels, ceil(width * scale) of them, each point a column
+    // layerScale pixels wide. New points scroll the image and only their columns get drawn; it
+    // is drawn from scratch only when the size or the display scale changes, always by paint()
+    // at the scale it paints at. A layerScale of 0 means it's out of date.
+    juce::Image waveform;
+    float layerScale = 0.0f;
+    int64_t columnsEnd = 0;  // columns since the last full render, where the newest one ends
+    void renderWaveform(float scale);
+    int columnEdge(int64_t column) const;
+    void drawColumns(size_t first, int count);
+    
+    void drawTap(juce::Graphics& g, float delay, juce::Colour colour);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EchoDisplay)
+};
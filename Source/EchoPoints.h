@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    EchoPoints.h
+    Created: 18 Oct 2026 9:37:15pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SPSCQueue.h"
+
+// A summary of the wet signal for the echo display: the audio thread reports the range of both
+// channels over every 1 / echoPointsPerSecond seconds, with the delay taps as they were at the
+// end of that stretch.
+struct EchoPoint
+{
+    float min;
+    float max;
+    float delay;        // seconds, where the delay is reading
+    float targetDelay;  // seconds, where it is heading (the same unless it's shifting)
+};
+
+inline constexpr int echoPointsPerSecond = 200;
+
+// About five seconds of points. Dropped when nobody reads, like BlockStats.
+using EchoQueue = SPSCQueue<EchoPoint, 1024>;
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    KnobFilmstrips.cpp
+    Created: 18 Oct 2026 7:14:36pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "KnobFilmstrips.h"
+
+JUCE_IMPLEMENT_SINGLETON (KnobFilmstrips)
+
+KnobFilmstrips::~KnobFilmstrips()
+{
+    renderThread.removeAllJobs(true, 5000);
+    clearSingletonInstance();
+}
+
+juce::Image KnobFilmstrips::getFrame(const Key& key, float sliderPos) const
+{
+    const juce::ScopedLock sl(lock);
+    
+    auto it = strips.find(key);
+    if (it == strips.end() || it->second.frames.empty()) {
+        return {};
+    }
+    it->second.lastUsed = ++useCount;
+    
+    int index = juce::jlimit(0, numFrames - 1, juce::roundToInt(sliderPos * float(numFrames - 1)));
+    return it->second.frames[size_t(index)];
+}
+
+void KnobFilmstrips::request(const Key& key, Renderer renderer)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        
+        if (strips.count(key) > 0) {
+            return;
+        }
+        
+        // the finished strip that went unused the longest makes room, the ones being rendered stay
+        while (strips.size() >= maxStrips) {
+            auto oldest = strips.end();
+            for (auto it = strips.begin(); it != strips.end(); ++it) {
+                bool finished = !it->second.frames.empty();
+                if (finished && (oldest == strips.end() || it->second.lastUsed < oldest->second.lastUsed)) {
+                    oldest = it;
+                }
+            }
+            if (oldest == strips.end()) {
+                break;
+            }
+            strips.erase(oldest);
+        }
+        
+        strips[key].lastUsed = ++useCount;
+    }
+    
+    renderThread.addJob([this, key, renderer = std::move(renderer)] { render(key, renderer); });
+}
+
+void KnobFilmstrips::render(const Key& key, const Renderer& renderer)
+{
+    int physicalSize = std::max(1, juce::roundToInt(float(key.size) * key.scale));
+    
+    std::vector<juce::Image> frames;
+    frames.reserve(size_t(numFrames));
+    
+    for (int i = 0; i < numFrames; ++i) {
+        // software images, so drawing them off the message thread is safe on every platform
+        juce::Image frame(juce::Image::ARGB, physicalSize, physicalSize, true, juce::SoftwareImageType());
+        {
+            juce::Graphics g(frame);
+            g.addTransform(juce::AffineTransform::scale(key.scale));
+            renderer(g, float(i) / float(numFrames - 1));
+        }
+        frames.push_back(std::move(frame));
+    }
+    
+    const juce::ScopedLock sl(lock);
+    strips[key].frames = std::move(frames);
+}
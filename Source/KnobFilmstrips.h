@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    KnobFilmstrips.h
+    Created: 18 Oct 2026 7:14:36pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Pre-rendered frames of a rotary knob, so that painting a knob is one image blit instead of
+// paths, strokes and a blurred shadow every time its value changes.
+//
+// A strip is numFrames images covering the whole rotary range, one strip per look (size,
+// display scale, angles, style). Strips are rendered on a background thread the first time
+// they're asked for; until one is ready the caller draws the knob the slow way. There's one
+// cache per process, so every knob in every plugin instance shares the same strips.
+class KnobFilmstrips : private juce::DeletedAtShutdown
+{
+public:
+    // odd, so that the middle of the range (where drawFromMiddle knobs rest) is an exact frame
+    static constexpr int numFrames = 129;
+    
+    struct Key
+    {
+        int size;           // width and height of the knob in logical pixels
+        float scale;        // physical pixels per logical pixel
+        float startAngle;
+        float endAngle;
+        bool drawFromMiddle;
+        bool enabled;
+        juce::uint32 fillColour;
+        
+        bool operator<(const Key& other) const noexcept
+        {
+            return std::tie(size, scale, startAngle, endAngle, drawFromMiddle, enabled, fillColour)
+                 < std::tie(other.size, other.scale, other.startAngle, other.endAngle,
+                            other.drawFromMiddle, other.enabled, other.fillColour);
+        }
+    };
+    
+    // Draws one frame into a context that is already scaled to logical pixels, with the knob
+    // filling (0, 0, size, size). Called on the render thread.
+    using Renderer = std::function<void(juce::Graphics& g, float sliderPos)>;
+    
+    // The frame nearest to sliderPos (0 to 1), or a null image if that strip isn't ready.
+    juce::Image getFrame(const Key& key, float sliderPos) const;
+    
+    // Queues the strip for rendering unless it's already there or on its way.
+    void request(const Key& key, Renderer renderer);
+    
+    ~KnobFilmstrips() override;
+    
+    JUCE_DECLARE_SINGLETON (KnobFilmstrips, false)
+    
+private:
+    KnobFilmstrips() = default;
+    
+    void render(const Key& key, const Renderer& renderer);
+    
+    // A changed display scale or window size leaves the old strips unused, so once there are
+    // this many the finished one that was drawn the longest ago makes room for the next.
+    static constexpr size_t maxStrips = 8;
+    
+    struct Strip
+    {
+        std::vector<juce::Image> frames;  // empty while the strip is still being rendered
+        mutable juce::uint64 lastUsed = 0;  // useCount when it was last drawn or requested
+    };
+    
+    std::map<Key, Strip> strips;
+    mutable juce::uint64 useCount = 0;
+    juce::CriticalSection lock;
+    
+    // declared last so it is stopped before anything it uses goes away
+    juce::ThreadPool renderThread { 1 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnobFilmstrips)
+};
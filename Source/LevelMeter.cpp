@@ -1,99 +1,189 @@
-/*
-  ==============================================================================
-
-    LevelMeter.cpp
-    Created: 5 Jun 2025 3:52:57pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "LevelMeter.h"
-#include "LookAndFeel.h"
-
-//==============================================================================
-LevelMeter::LevelMeter(Measurement& measurementL_, Measurement& measurementR_)
-    :   measurementL(measurementL_),
-        measurementR(measurementR_),
-        dbLevelL(clampdB),
-        dbLevelR(clampdB)
-{
-    setOpaque(true);
-    startTimerHz(refreshRate);
-    
-    decay = 1.0f - std::exp(-1.0f / (float(refreshRate) * 0.2f));
-}
-
-LevelMeter::~LevelMeter()
-{
-}
-
-void LevelMeter::paint (juce::Graphics& g)
-{
-    const auto bounds = getLocalBounds();
-    
-    g.fillAll(Colors::background);
-
-    g.setColour(Colors::LevelMeter::background);
-    g.fillRoundedRectangle(0.0f, 0.0f, bounds.getWidth(), bounds.getHeight(), 5.0f);
-    
-    drawLevel(g, dbLevelL, 0, 7);
-    drawLevel(g, dbLevelR, 9, 7);
-
-    g.setFont(Fonts::getFont(10.0f));
-    for (float db = maxdB; db >= mindB; db -= stepdB) {
-        int y = positionForLevel(db);
-        
-        g.setColour(Colors::LevelMeter::tickLine);
-        g.fillRect(0, y, 16, 1);
-        
-        g.setColour(Colors::LevelMeter::tickLabel);
-        g.drawSingleLineText(juce::String(int(db)), bounds.getWidth(), y+3, juce::Justification::right);
-    }
-}
-
-void LevelMeter::resized()
-{
-    maxPos = 4.0f;
-    minPos = float(getHeight() - 4.0f);
-
-}
-
-void LevelMeter::timerCallback()
-{
-    updateLevel(measurementL.readAndReset(), levelL, dbLevelL);
-    updateLevel(measurementR.readAndReset(), levelR, dbLevelR);
-    
-    repaint();
-}
-
-void LevelMeter::drawLevel(juce::Graphics &g, float level, int x, int width)
-{
-    int y = positionForLevel(level);
-    if (level > 0.0f) {
-        int y0 = positionForLevel(0.0f);
-        g.setColour(Colors::LevelMeter::tooLoud);
-        g.fillRect(x, y, width, y0 - y);
-        g.setColour(Colors::LevelMeter::levelOK);
-        g.fillRect(x, y0, width, getHeight() - y0);
-    } else if (y < getHeight()) {
-        g.setColour(Colors::LevelMeter::levelOK);
-        g.fillRect(x, y, width, getHeight() - y);
-    }
-}
-
-void LevelMeter::updateLevel(float newLevel, float& smoothedLevel, float& leveldB) const
-{
-    if (newLevel > smoothedLevel) {
-        smoothedLevel = newLevel;
-    } else {
-        smoothedLevel += (newLevel - smoothedLevel) * decay;
-    }
-    
-    if (smoothedLevel > clampLevel) {
-        leveldB = juce::Decibels::gainToDecibels(smoothedLevel);
-    } else {
-        leveldB = clampdB;
-    }
-}
+/*
+  ==============================================================================
+
+    LevelMeter.cpp
+    Created: 5 Jun 2025 3:52:57pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "LevelMeter.h"
+#include "LookAndFeel.h"
+#include "Trace.h"
+
+//==============================================================================
+LevelMeter::LevelMeter(BlockStatsQueue& blockStats_, juce::AudioParameterBool& truePeakParam_)
+    :   blockStats(blockStats_),
+        truePeakParam(truePeakParam_),
+        dbLevelL(clampdB),
+        dbLevelR(clampdB)
+{
+    // whatever piled up while no editor was open is too old to show
+    blockStats.discardAll();
+    
+    setOpaque(true);
+    refreshScheduler->add(*this, *this);
+}
+
+LevelMeter::~LevelMeter()
+{
+    refreshScheduler->remove(*this);
+}
+
+void LevelMeter::paint (juce::Graphics& g)
+{
+    BROCDELAY_TRACE_SCOPE("LevelMeter::paint");
+    
+    // the scale the layers are drawn at is the one this context paints at, nothing else
+    float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (scale != layerScale || truePeakParam.get() != layerTruePeak) {
+        renderStaticLayers(scale);
+    }
+    
+    const auto bounds = getLocalBounds().toFloat();
+    g.drawImage(backgroundLayer, bounds);
+    
+    drawLevel(g, dbLevelL, barXL, barWidth);
+    drawLevel(g, dbLevelR, barXR, barWidth);
+    
+    g.drawImage(scaleLayer, bounds);
+}
+
+void LevelMeter::renderStaticLayers(float scale)
+{
+    layerScale = scale;
+    layerTruePeak = truePeakParam.get();
+    
+    const auto bounds = getLocalBounds();
+    int imageWidth = std::max(1, juce::roundToInt(float(bounds.getWidth()) * scale));
+    int imageHeight = std::max(1, juce::roundToInt(float(bounds.getHeight()) * scale));
+    
+    backgroundLayer = juce::Image(juce::Image::RGB, imageWidth, imageHeight, true);
+    {
+        juce::Graphics g(backgroundLayer);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        
+        g.fillAll(Colors::background);
+        
+        g.setColour(Colors::LevelMeter::background);
+        g.fillRoundedRectangle(0.0f, 0.0f, bounds.getWidth(), meterBottom(), 5.0f);
+        
+        g.setFont(Fonts::getFont(10.0f));
+        g.setColour(Colors::LevelMeter::tickLabel);
+        g.drawText(layerTruePeak ? "TP" : "PK", bounds.withTop(meterBottom()), juce::Justification::centred);
+    }
+    
+    scaleLayer = juce::Image(juce::Image::ARGB, imageWidth, imageHeight, true);
+    {
+        juce::Graphics g(scaleLayer);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        
+        g.setFont(Fonts::getFont(10.0f));
+        for (float db = maxdB; db >= mindB; db -= stepdB) {
+            int y = positionForLevel(db);
+            
+            g.setColour(Colors::LevelMeter::tickLine);
+            g.fillRect(0, y, 16, 1);
+            
+            g.setColour(Colors::LevelMeter::tickLabel);
+            g.drawSingleLineText(juce::String(int(db)), bounds.getWidth(), y+3, juce::Justification::right);
+        }
+    }
+}
+
+void LevelMeter::resized()
+{
+    maxPos = 4.0f;
+    minPos = float(getHeight() - modeLabelHeight - 4.0f);
+    
+    // drawn again by the next paint()
+    layerScale = 0.0f;
+    barTopL = meterBottom();
+    barTopR = meterBottom();
+}
+
+void LevelMeter::refresh(double elapsedSeconds)
+{
+    // loudest peak of all the blocks since the last frame
+    bool truePeak = truePeakParam.get();
+    float peakL = 0.0f;
+    float peakR = 0.0f;
+    blockStats.drain([&] (const BlockStats& stats) {
+        peakL = std::max(peakL, truePeak ? stats.truePeakL : stats.peakL);
+        peakR = std::max(peakR, truePeak ? stats.truePeakR : stats.peakR);
+    });
+    
+    // frames don't always come at the same rate, so the decay follows the time that passed
+    float decay = 1.0f - std::exp(-float(elapsedSeconds) / releaseTime);
+    updateLevel(peakL, levelL, dbLevelL, decay);
+    updateLevel(peakR, levelR, dbLevelR, decay);
+    
+    updateBar(dbLevelL, barTopL, barXL, barWidth);
+    updateBar(dbLevelR, barTopR, barXR, barWidth);
+    
+    if (truePeak != layerTruePeak) {
+        repaint(getLocalBounds().withTop(meterBottom()));
+    }
+}
+
+void LevelMeter::updateBar(float dbLevel, int& barTop, int x, int width)
+{
+    // nothing to do when the bar ends on the same pixel row as before
+    int newTop = juce::jlimit(0, meterBottom(), positionForLevel(dbLevel));
+    if (newTop != barTop) {
+        int top = std::min(barTop, newTop);
+        repaint(x, top, width, std::max(barTop, newTop) - top);
+        barTop = newTop;
+    }
+}
+
+void LevelMeter::mouseDown([[maybe_unused]] const juce::MouseEvent& event)
+{
+    truePeakParam.beginChangeGesture();
+    truePeakParam.setValueNotifyingHost(truePeakParam.get() ? 0.0f : 1.0f);
+    truePeakParam.endChangeGesture();
+}
+
+void LevelMeter::mouseEnter([[maybe_unused]] const juce::MouseEvent& event)
+{
+    if (onHover)
+        onHover("The meter shows the output peaks. Click it to switch between sample peaks (PK) and true peaks (TP), which also catch the overs between samples.");
+}
+
+void LevelMeter::mouseExit([[maybe_unused]] const juce::MouseEvent& event)
+{
+    if (onHover)
+        onHover("");
+}
+
+void LevelMeter::drawLevel(juce::Graphics &g, float level, int x, int width)
+{
+    int y = positionForLevel(level);
+    if (level > 0.0f) {
+        int y0 = positionForLevel(0.0f);
+        g.setColour(Colors::LevelMeter::tooLoud);
+        g.fillRect(x, y, width, y0 - y);
+        g.setColour(Colors::LevelMeter::levelOK);
+        g.fillRect(x, y0, width, meterBottom() - y0);
+    } else if (y < meterBottom()) {
+        g.setColour(Colors::LevelMeter::levelOK);
+        g.fillRect(x, y, width, meterBottom() - y);
+    }
+}
+
+void LevelMeter::updateLevel(float newLevel, float& smoothedLevel, float& leveldB, float decay) const
+{
+    if (newLevel > smoothedLevel) {
+        smoothedLevel = newLevel;
+    } else {
+        smoothedLevel += (newLevel - smoothedLevel) * decay;
+    }
+    
+    if (smoothedLevel > clampLevel) {
+        leveldB = juce::Decibels::gainToDecibels(smoothedLevel);
+    } else {
+        leveldB = clampdB;
+    }
+}
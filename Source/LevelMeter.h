@@ -1,64 +1,100 @@
-/*
-  ==============================================================================
-
-    LevelMeter.h
-    Created: 5 Jun 2025 3:52:57pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "Measurement.h"
-
-//==============================================================================
-/*
-*/
-class LevelMeter  : public juce::Component, private juce::Timer
-{
-public:
-    LevelMeter(Measurement& measurementL,
-               Measurement& measurementR);
-    ~LevelMeter() override;
-
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    void timerCallback() override;
-    
-    Measurement& measurementL;
-    Measurement& measurementR;
-    
-    static constexpr float maxdB = 6.0f;
-    static constexpr float mindB = -60.0f;
-    static constexpr float stepdB = 6.0f;
-    
-    float maxPos = 0.0f;
-    float minPos = 0.0f;
-    
-    static constexpr float clampdB = -120.0f;
-    static constexpr float clampLevel = 0.000001f;
-    
-    float dbLevelL;
-    float dbLevelR;
-    
-    static constexpr int refreshRate = 60;
-    
-    float decay = 0.0f;
-    float levelL = clampLevel;
-    float levelR = clampLevel;
-    
-    int positionForLevel(float dbLevel) const noexcept
-    {
-        return int(std::round(juce::jmap(dbLevel, maxdB, mindB, maxPos, minPos)));
-    }
-    
-    void drawLevel(juce::Graphics& g, float level, int x, int width);
-    
-    void updateLevel(float newLevel, float& smoothedLevel, float& leveldB) const;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
-};
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 5 Jun 2025 3:52:57pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BlockStats.h"
+#include "RefreshScheduler.h"
+
+//==============================================================================
+/*
+*/
+class LevelMeter  : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    // The meter is the only reader of the queue. Clicking it toggles truePeakParam.
+    LevelMeter(BlockStatsQueue& blockStats, juce::AudioParameterBool& truePeakParam);
+    ~LevelMeter() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseEnter(const juce::MouseEvent& event) override;
+    void mouseExit(const juce::MouseEvent& event) override;
+    
+    std::function<void(const juce::String&)> onHover;
+    
+    // height of the "PK" / "TP" label under the scale
+    static constexpr int modeLabelHeight = 14;
+
+private:
+    void refresh(double elapsedSeconds) override;
+    
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;
+    
+    BlockStatsQueue& blockStats;
+    juce::AudioParameterBool& truePeakParam;
+    
+    static constexpr float maxdB = 6.0f;
+    static constexpr float mindB = -60.0f;
+    static constexpr float stepdB = 6.0f;
+    
+    float maxPos = 0.0f;
+    float minPos = 0.0f;
+    
+    // bottom edge of the bars, the mode label is below it
+    int meterBottom() const noexcept
+    {
+        return getHeight() - modeLabelHeight;
+    }
+    
+    // The parts that don't move (background, rounded rect and mode label underneath the bars,
+    // tick lines and labels on top of them) are only drawn again when the size, the display
+    // scale or the mode changes. Always from paint(), a layerScale of 0 means they're out of date.
+    void renderStaticLayers(float scale);
+    juce::Image backgroundLayer;
+    juce::Image scaleLayer;
+    float layerScale = 0.0f;
+    bool layerTruePeak = false;
+    
+    // top of each bar as last painted, so only the part of a bar that moved gets repainted
+    int barTopL = 0;
+    int barTopR = 0;
+    void updateBar(float dbLevel, int& barTop, int x, int width);
+    
+    static constexpr int barWidth = 7;
+    static constexpr int barXL = 0;
+    static constexpr int barXR = 9;
+    
+    static constexpr float clampdB = -120.0f;
+    static constexpr float clampLevel = 0.000001f;
+    
+    float dbLevelL;
+    float dbLevelR;
+    
+    // time for the level to fall by 1 - 1/e
+    static constexpr float releaseTime = 0.2f;
+    
+    float levelL = clampLevel;
+    float levelR = clampLevel;
+    
+    int positionForLevel(float dbLevel) const noexcept
+    {
+        return int(std::round(juce::jmap(dbLevel, maxdB, mindB, maxPos, minPos)));
+    }
+    
+    void drawLevel(juce::Graphics& g, float level, int x, int width);
+    
+    void updateLevel(float newLevel, float& smoothedLevel, float& leveldB, float decay) const;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
+};
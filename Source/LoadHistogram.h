@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    LoadHistogram.h
+    Created: 18 Oct 2026 11:20:46pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include "CacheLine.h"
+
+// Builds that don't want the load meter (or its two clock reads per block) define this as 0,
+// e.g. in the exporter's preprocessor definitions. processBlock then doesn't time anything.
+#ifndef BROCDELAY_LOAD_METER
+ #define BROCDELAY_LOAD_METER 1
+#endif
+
+// How much of the real-time budget each block used (processing time divided by
+// numSamples / sampleRate), counted into logarithmic buckets: four per octave from 1/16384
+// (0.006%) up to 16x (1600%). One thread adds, any other thread reads; nothing locks or waits.
+//
+// The counters only ever grow. Readers take a snapshot now and then and look at the
+// difference to the previous one, so every reader gets its own window without the audio
+// thread having to reset anything.
+class LoadHistogram
+{
+public:
+    static constexpr int bucketsPerOctave = 4;
+    static constexpr int minOctave = -14;
+    static constexpr int numOctaves = 18;
+    static constexpr int numBuckets = numOctaves * bucketsPerOctave;
+
+    struct Snapshot
+    {
+        std::array<uint32_t, numBuckets> counts {};
+        uint64_t numBlocks = 0;
+        double loadSum = 0.0;
+    };
+
+    struct Summary
+    {
+        uint64_t numBlocks = 0;
+        float mean = 0.0f;
+        float p99 = 0.0f;  // upper edge of the bucket the 99th percentile falls into
+        float max = 0.0f;
+    };
+
+    // The one writer, normally the audio thread
+    void add(float load) noexcept
+    {
+        int bucket = 0;
+        if (load > 0.0f) {
+            bucket = int(std::floor((std::log2(load) - float(minOctave)) * float(bucketsPerOctave)));
+            bucket = std::min(std::max(bucket, 0), numBuckets - 1);
+        }
+
+        // single writer, so a plain load and store instead of a locked read-modify-write
+        auto& count = counts[size_t(bucket)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        loadSum.store(loadSum.load(std::memory_order_relaxed) + double(load), std::memory_order_relaxed);
+        // takeMax() resets this one from the reader's side, so a plain store could put back the
+        // maximum of the window that was just taken. Only loops when takeMax() got in between.
+        float max = maxLoad.load(std::memory_order_relaxed);
+        while (load > max && !maxLoad.compare_exchange_weak(max, load, std::memory_order_relaxed)) {
+        }
+        numBlocks.store(numBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Readers
+    Snapshot snapshot() const noexcept
+    {
+        Snapshot result;
+        result.numBlocks = numBlocks.load(std::memory_order_acquire);
+        result.loadSum = loadSum.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < counts.size(); ++i) {
+            result.counts[i] = counts[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // The largest load since the last call. Meant for a single reader; a block finishing at the
+    // same moment counts in exactly one of the two windows.
+    float takeMax() noexcept
+    {
+        return maxLoad.exchange(0.0f, std::memory_order_relaxed);
+    }
+
+    static float bucketUpperEdge(int bucket) noexcept
+    {
+        return std::exp2(float(bucket + 1) / float(bucketsPerOctave) + float(minOctave));
+    }
+
+    // Statistics of the blocks added between two snapshots
+    static Summary summarize(const Snapshot& from, const Snapshot& to, float max) noexcept
+    {
+        Summary summary;
+        summary.numBlocks = to.numBlocks - from.numBlocks;
+        summary.max = max;
+        if (summary.numBlocks == 0) {
+            return summary;
+        }
+
+        summary.mean = float((to.loadSum - from.loadSum) / double(summary.numBlocks));
+
+        // the counters are read one by one, so their total can be a little off numBlocks
+        uint64_t total = 0;
+        for (int i = 0; i < numBuckets; ++i) {
+            total += uint32_t(to.counts[size_t(i)] - from.counts[size_t(i)]);
+        }
+        uint64_t below = 0;
+        for (int i = 0; i < numBuckets; ++i) {
+            below += uint32_t(to.counts[size_t(i)] - from.counts[size_t(i)]);
+            if (double(below) >= 0.99 * double(total)) {
+                summary.p99 = bucketUpperEdge(i);
+                if (max > 0.0f) {
+                    summary.p99 = std::min(summary.p99, max);
+                }
+                break;
+            }
+        }
+        return summary;
+    }
+
+private:
+    alignas(cacheLineSize) std::array<std::atomic<uint32_t>, numBuckets> counts {};
+    std::atomic<uint64_t> numBlocks { 0 };
+    std::atomic<double> loadSum { 0.0 };
+    std::atomic<float> maxLoad { 0.0f };
+};
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    LoadMeter.cpp
+    Created: 18 Oct 2026 11:27:15pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "LoadMeter.h"
+#include "LookAndFeel.h"
+#include "Trace.h"
+
+//==============================================================================
+LoadMeter::LoadMeter(LoadHistogram& histogram_)
+    :   histogram(histogram_),
+        lastSnapshot(histogram_.snapshot())
+{
+    // the first window starts now, not when the plugin was loaded
+    histogram.takeMax();
+    
+    setOpaque(true);
+    refreshScheduler->add(*this, *this);
+}
+
+LoadMeter::~LoadMeter()
+{
+    refreshScheduler->remove(*this);
+}
+
+void LoadMeter::paint (juce::Graphics& g)
+{
+    BROCDELAY_TRACE_SCOPE("LoadMeter::paint");
+    
+    g.fillAll(Colors::header);
+    
+    auto bounds = getLocalBounds();
+    
+    g.setColour(Colors::LoadMeter::mean);
+    g.setFont(Fonts::getFont(13.0f));
+    g.drawText(meanText, bounds.removeFromTop(bounds.getHeight() / 2), juce::Justification::bottomRight);
+    
+    g.setColour(Colors::LoadMeter::detail);
+    g.setFont(Fonts::getFont(10.0f));
+    g.drawText(detailText, bounds, juce::Justification::topRight);
+}
+
+void LoadMeter::refresh(double elapsedSeconds)
+{
+    sinceUpdate += elapsedSeconds;
+    if (sinceUpdate < updateInterval && meanText.isNotEmpty()) {
+        return;
+    }
+    sinceUpdate = 0.0;
+    
+    auto snapshot = histogram.snapshot();
+    auto summary = LoadHistogram::summarize(lastSnapshot, snapshot, histogram.takeMax());
+    lastSnapshot = snapshot;
+    
+    juce::String newMeanText = "DSP --";
+    juce::String newDetailText;
+    if (summary.numBlocks > 0) {
+        newMeanText = "DSP " + formatLoad(summary.mean);
+        newDetailText = "p99 " + formatLoad(summary.p99) + "  max " + formatLoad(summary.max);
+    }
+    
+    if (newMeanText != meanText || newDetailText != detailText) {
+        meanText = newMeanText;
+        detailText = newDetailText;
+        repaint();
+    }
+}
+
+juce::String LoadMeter::formatLoad(float load)
+{
+    float percent = load * 100.0f;
+    return juce::String(percent, percent < 10.0f ? 1 : 0) + "%";
+}
+
+void LoadMeter::mouseEnter([[maybe_unused]] const juce::MouseEvent& event)
+{
+    if (onHover)
+        onHover("How much of the time available for each audio block the delay needed over the last half second: the average, the 99th percentile and the slowest block. Near 100% the host starts to drop out.");
+}
+
+void LoadMeter::mouseExit([[maybe_unused]] const juce::MouseEvent& event)
+{
+    if (onHover)
+        onHover("");
+}
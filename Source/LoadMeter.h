@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    LoadMeter.h
+    Created: 18 Oct 2026 11:27:15pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LoadHistogram.h"
+#include "RefreshScheduler.h"
+
+//==============================================================================
+/*
+    How much of the real-time budget processBlock used over the last half second: the
+    average on top, the 99th percentile and the worst block underneath.
+*/
+class LoadMeter  : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    LoadMeter(LoadHistogram& histogram);
+    ~LoadMeter() override;
+
+    void paint (juce::Graphics&) override;
+    
+    void mouseEnter(const juce::MouseEvent& event) override;
+    void mouseExit(const juce::MouseEvent& event) override;
+    
+    std::function<void(const juce::String&)> onHover;
+
+private:
+    void refresh(double elapsedSeconds) override;
+    
+    static juce::String formatLoad(float load);
+    
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;
+    
+    LoadHistogram& histogram;
+    LoadHistogram::Snapshot lastSnapshot;
+    
+    // numbers that change every frame can't be read, so they're only updated this often
+    static constexpr double updateInterval = 0.5;
+    double sinceUpdate = 0.0;
+    
+    juce::String meanText;
+    juce::String detailText;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadMeter)
+};
@@ -1,169 +1,202 @@
-/*
-  ==============================================================================
-
-    LookAndFeel.h
-    Created: 30 Apr 2025 9:02:30pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-namespace Colors
-{
-    const juce::Colour background { 0, 100, 0 };
-    const juce::Colour header { 0, 60, 0 };
-
-    namespace Knob
-    {
-        const juce::Colour trackBackground { 100, 160, 100 };
-        const juce::Colour trackActive { 150, 220, 150 };
-        const juce::Colour outline { 255, 250, 245 };
-        const juce::Colour gradientTop { 240, 250, 240 };
-        const juce::Colour gradientBottom { 210, 235, 210 };
-        const juce::Colour dial { 0, 150, 0 };
-        const juce::Colour dropShadow { 195, 190, 185 };
-        const juce::Colour label { 255, 255, 255 };
-        const juce::Colour textBoxBackground { 0, 60, 0 };
-        const juce::Colour value { 240, 240, 240 };
-        const juce::Colour caret { 255, 255, 255 };
-    }
-
-    namespace Switch
-    {
-        const juce::Colour inactiveGradientTop { 200, 220, 200 };
-        const juce::Colour inactiveGradientBottom { 180, 200, 180 };
-        const juce::Colour activeGradientTop {150, 220, 150};
-        const juce::Colour activeGradientBottom { 200, 220, 200 };
-        const juce::Colour dropShadow {210, 255, 210};
-        const juce::Colour outline { 100, 160, 100 };
-    }
-
-    namespace LevelMeter
-    {
-    const juce::Colour background { 0, 60, 0 };
-        const juce::Colour tickLine { 100, 160, 100 };
-        const juce::Colour tickLabel { 240, 240, 240 };
-        const juce::Colour tooLoud { 226, 74, 81 };
-        const juce::Colour levelOK { 65, 206, 88 };
-    }
-
-    namespace Group
-    {
-        const juce::Colour label { 150, 220, 150 };
-        const juce::Colour outline { 235, 230, 225 };
-    }
-
-    namespace Footer
-    {
-        const juce::Colour footerText { 150, 220, 150 };	
-    }
-}
-
-class Fonts
-{
-public:
-    static juce::Font getFont(float height = 16.0f);
-    
-    Fonts() = delete;
-    
-private:
-    static const juce::Typeface::Ptr typeface;
-};
-
-class RotaryKnobLookAndFeel : public juce::LookAndFeel_V4
-{
-public:
-    RotaryKnobLookAndFeel();
-    
-    static RotaryKnobLookAndFeel* get()
-    {
-        static RotaryKnobLookAndFeel instance;
-        return &instance;
-    }
-    
-    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider) override;
-    
-    juce::Font getLabelFont(juce::Label&) override;
-    
-    juce::Label* createSliderTextBox(juce::Slider&) override;
-    
-    void drawTextEditorOutline(juce:: Graphics&, int, int, juce::TextEditor&) override {}
-    
-    void fillTextEditorBackground(juce::Graphics&, int width, int height, juce::TextEditor&) override;
-    
-private:
-    juce::DropShadow dropShadow { Colors::Knob::dropShadow, 6, { 0, 3 } };
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RotaryKnobLookAndFeel)
-};
-
-class SwitchLookAndFeel : public juce::LookAndFeel_V4
-{
-public:
-    SwitchLookAndFeel();
-    
-    static SwitchLookAndFeel* get()
-    {
-        static SwitchLookAndFeel instance;
-        return &instance;
-    }
-    
-    void drawToggleButton(juce::Graphics& g,
-                          juce::ToggleButton& toggleButton,
-                          bool shouldDrawButtonAsHighlighted,
-                          bool shouldDrawButtonAsDown) override;
-    
-private:
-    juce::DropShadow dropShadow { Colors::Switch::dropShadow, 8, { 0, 0 } };
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SwitchLookAndFeel)
-};
-
-class HorizontalSliderLookAndFeel : public juce::LookAndFeel_V4
-{
-public:
-    HorizontalSliderLookAndFeel();
-    
-    static HorizontalSliderLookAndFeel* get()
-    {
-        static HorizontalSliderLookAndFeel instance;
-        return &instance;
-    }
-    
-    void drawLabel(juce::Graphics& g, juce::Label& label) override;
-    
-    void drawLinearSlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, juce::Slider::SliderStyle sliderStyle, juce::Slider& slider) override;
-    
-    juce::Font getLabelFont(juce::Label&) override;
-    
-private:
-    juce::DropShadow dropShadow { Colors::Knob::dropShadow, 6, { 0, 3 } };
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HorizontalSliderLookAndFeel)
-};
-
-class FooterLookAndFeel : public juce::LookAndFeel_V4
-{
-public:
-    FooterLookAndFeel();
-    
-    juce::Font getLabelFont(juce::Label&) override;
-    
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FooterLookAndFeel)
-};
-
-class MainLookAndFeel : public juce::LookAndFeel_V4
-{
-public:
-    MainLookAndFeel();
-    
-    juce::Font getLabelFont(juce::Label&) override;
-    
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainLookAndFeel)
-};
+/*
+  ==============================================================================
+
+    LookAndFeel.h
+    Created: 30 Apr 2025 9:02:30pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KnobFilmstrips.h"
+
+namespace Colors
+{
+    const juce::Colour background { 0, 100, 0 };
+    const juce::Colour header { 0, 60, 0 };
+
+    namespace Knob
+    {
+        const juce::Colour trackBackground { 100, 160, 100 };
+        const juce::Colour trackActive { 150, 220, 150 };
+        const juce::Colour outline { 255, 250, 245 };
+        const juce::Colour gradientTop { 240, 250, 240 };
+        const juce::Colour gradientBottom { 210, 235, 210 };
+        const juce::Colour dial { 0, 150, 0 };
+        const juce::Colour dropShadow { 195, 190, 185 };
+        const juce::Colour label { 255, 255, 255 };
+        const juce::Colour textBoxBackground { 0, 60, 0 };
+        const juce::Colour value { 240, 240, 240 };
+        const juce::Colour caret { 255, 255, 255 };
+    }
+
+    namespace Switch
+    {
+        const juce::Colour inactiveGradientTop { 200, 220, 200 };
+        const juce::Colour inactiveGradientBottom { 180, 200, 180 };
+        const juce::Colour activeGradientTop {150, 220, 150};
+        const juce::Colour activeGradientBottom { 200, 220, 200 };
+        const juce::Colour dropShadow {210, 255, 210};
+        const juce::Colour outline { 100, 160, 100 };
+    }
+
+    namespace LevelMeter
+    {
+    const juce::Colour background { 0, 60, 0 };
+        const juce::Colour tickLine { 100, 160, 100 };
+        const juce::Colour tickLabel { 240, 240, 240 };
+        const juce::Colour tooLoud { 226, 74, 81 };
+        const juce::Colour levelOK { 65, 206, 88 };
+    }
+
+    namespace EchoDisplay
+    {
+        const juce::Colour background { 0, 60, 0 };
+        const juce::Colour centreLine { 100, 160, 100 };
+        const juce::Colour waveform { 150, 220, 150 };
+        const juce::Colour tap { 255, 250, 245 };
+        const juce::Colour targetTap { 226, 74, 81 };
+    }
+
+    namespace SpectrumDisplay
+    {
+        const juce::Colour background { 0, 60, 0 };
+        const juce::Colour spectrum { 100, 160, 100 };
+        const juce::Colour response { 255, 250, 245 };
+    }
+
+    namespace LoadMeter
+    {
+        const juce::Colour mean { 150, 220, 150 };
+        const juce::Colour detail { 100, 160, 100 };
+    }
+
+    namespace Group
+    {
+        const juce::Colour label { 150, 220, 150 };
+        const juce::Colour outline { 235, 230, 225 };
+    }
+
+    namespace Footer
+    {
+        const juce::Colour footerText { 150, 220, 150 };	
+    }
+}
+
+class Fonts
+{
+public:
+    static juce::Font getFont(float height = 16.0f);
+    
+    Fonts() = delete;
+    
+private:
+    // loaded by the first call rather than when the plugin binary is loaded
+    static const juce::Typeface::Ptr& getTypeface();
+};
+
+class RotaryKnobLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    RotaryKnobLookAndFeel();
+    
+    static RotaryKnobLookAndFeel* get()
+    {
+        static RotaryKnobLookAndFeel instance;
+        return &instance;
+    }
+    
+    void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider) override;
+    
+    juce::Font getLabelFont(juce::Label&) override;
+    
+    juce::Label* createSliderTextBox(juce::Slider&) override;
+    
+    void drawTextEditorOutline(juce:: Graphics&, int, int, juce::TextEditor&) override {}
+    
+    void fillTextEditorBackground(juce::Graphics&, int width, int height, juce::TextEditor&) override;
+    
+private:
+    // Draws the knob the slow way, for the filmstrip frames and for as long as the strip
+    // isn't ready yet. Also called on the filmstrip render thread, so any image it needs on the
+    // way has to be a software image.
+    void drawKnob(juce::Graphics& g, juce::Rectangle<float> bounds, float sliderPos,
+                  const KnobFilmstrips::Key& style) const;
+    
+    // dropShadow under path, drawn through software images only
+    void drawShadowForPath(juce::Graphics& g, const juce::Path& path) const;
+    
+    juce::DropShadow dropShadow { Colors::Knob::dropShadow, 6, { 0, 3 } };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RotaryKnobLookAndFeel)
+};
+
+class SwitchLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    SwitchLookAndFeel();
+    
+    static SwitchLookAndFeel* get()
+    {
+        static SwitchLookAndFeel instance;
+        return &instance;
+    }
+    
+    void drawToggleButton(juce::Graphics& g,
+                          juce::ToggleButton& toggleButton,
+                          bool shouldDrawButtonAsHighlighted,
+                          bool shouldDrawButtonAsDown) override;
+    
+private:
+    juce::DropShadow dropShadow { Colors::Switch::dropShadow, 8, { 0, 0 } };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SwitchLookAndFeel)
+};
+
+class HorizontalSliderLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    HorizontalSliderLookAndFeel();
+    
+    static HorizontalSliderLookAndFeel* get()
+    {
+        static HorizontalSliderLookAndFeel instance;
+        return &instance;
+    }
+    
+    void drawLabel(juce::Graphics& g, juce::Label& label) override;
+    
+    void drawLinearSlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, juce::Slider::SliderStyle sliderStyle, juce::Slider& slider) override;
+    
+    juce::Font getLabelFont(juce::Label&) override;
+    
+private:
+    juce::DropShadow dropShadow { Colors::Knob::dropShadow, 6, { 0, 3 } };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HorizontalSliderLookAndFeel)
+};
+
+class FooterLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    FooterLookAndFeel();
+    
+    juce::Font getLabelFont(juce::Label&) override;
+    
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FooterLookAndFeel)
+};
+
+class MainLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    MainLookAndFeel();
+    
+    juce::Font getLabelFont(juce::Label&) override;
+    
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainLookAndFeel)
+};
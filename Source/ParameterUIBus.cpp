@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    ParameterUIBus.cpp
+    Created: 18 Oct 2026 8:03:52pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "ParameterUIBus.h"
+#include "Trace.h"
+
+ParameterUIBus::ParameterUIBus(juce::Component& owner)
+{
+    refreshScheduler->add(owner, *this);
+}
+
+ParameterUIBus::~ParameterUIBus()
+{
+    refreshScheduler->remove(*this);
+    
+    // the same parameter may be in here more than once, removing it twice is harmless
+    for (auto& subscription : subscriptions) {
+        subscription.parameter->removeListener(this);
+    }
+}
+
+void ParameterUIBus::subscribe(juce::AudioProcessorParameter& parameter, std::function<void()> onChange)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(parameter.getParameterIndex() >= 0 && parameter.getParameterIndex() < maxParameters);
+    
+    bool alreadyListening = std::any_of(subscriptions.begin(), subscriptions.end(), [&] (const auto& s) {
+        return s.parameter == &parameter;
+    });
+    
+    subscriptions.push_back({ &parameter, std::move(onChange) });
+    
+    if (!alreadyListening) {
+        parameter.addListener(this);
+    }
+}
+
+void ParameterUIBus::parameterValueChanged(int parameterIndex, [[maybe_unused]] float newValue)
+{
+    // any thread, often the audio thread
+    if (parameterIndex >= 0 && parameterIndex < maxParameters) {
+        auto bit = juce::uint64(1) << (parameterIndex % 64);
+        dirty[size_t(parameterIndex / 64)].fetch_or(bit, std::memory_order_release);
+    }
+}
+
+void ParameterUIBus::refresh([[maybe_unused]] double elapsedSeconds)
+{
+    BROCDELAY_TRACE_SCOPE("ParameterUIBus::refresh");
+    
+    for (size_t word = 0; word < dirty.size(); ++word) {
+        auto bits = dirty[word].exchange(0, std::memory_order_acquire);
+        if (bits == 0) {
+            continue;
+        }
+        
+        for (auto& subscription : subscriptions) {
+            int index = subscription.parameter->getParameterIndex();
+            if (index / 64 == int(word) && (bits & (juce::uint64(1) << (index % 64))) != 0) {
+                subscription.onChange();
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    ParameterUIBus.h
+    Created: 18 Oct 2026 8:03:52pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "RefreshScheduler.h"
+
+// Gets parameter changes that the UI has to react to (which knobs are visible, mode labels,
+// displays) from whatever thread the host changes them on to the message thread.
+//
+// The parameter side only sets a bit for the parameter in a lock-free bitset, so automation
+// on the audio thread costs one atomic OR and never allocates. Once per frame (see
+// RefreshScheduler) the bits are swapped out and each changed parameter's callbacks run
+// once, however many times it moved in between. Nothing outlives the owner: the listeners
+// are removed in the destructor, after which no callback can be running.
+class ParameterUIBus : private juce::AudioProcessorParameter::Listener,
+                       private RefreshScheduler::Client
+{
+public:
+    // Callbacks stop while the owner isn't showing and catch up when it is again.
+    explicit ParameterUIBus(juce::Component& owner);
+    ~ParameterUIBus() override;
+    
+    // Call from the message thread. onChange runs on the message thread.
+    void subscribe(juce::AudioProcessorParameter& parameter, std::function<void()> onChange);
+    
+private:
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override { }
+    
+    void refresh(double elapsedSeconds) override;
+    
+    struct Subscription
+    {
+        juce::AudioProcessorParameter* parameter;
+        std::function<void()> onChange;
+    };
+    std::vector<Subscription> subscriptions;
+    
+    // one bit per parameter index
+    static constexpr int maxParameters = 128;
+    std::array<std::atomic<juce::uint64>, maxParameters / 64> dirty {};
+    
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterUIBus)
+};
@@ -1,371 +1,275 @@
-/*
-  ==============================================================================
-
-    Parameters.cpp
-    Created: 26 Apr 2025 3:11:09pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#include "Parameters.h"
-#include "DSP.h"
-
-// Helper function to cast Parameter values to usable types
-template<typename T> static void castParameter(juce::AudioProcessorValueTreeState& apvts,
-                                               const juce::ParameterID& id, T& destination)
-{
-    destination = dynamic_cast<T>(apvts.getParameter(id.getParamID()));
-    jassert(destination); // parameter does not exist or wrong type
-}
-
-static juce::String stringFromMilliseconds(float value, int)
-{
-    if (value < 10.0f) {
-        return juce::String(value, 2) + "ms";
-    } else if (value < 100.f) {
-        return juce::String(value, 1) + "ms";
-    } else if (value < 1000.0f) {
-        return juce::String(int(value)) + "ms";
-    } else {
-        return juce::String(value * 0.001f, 2) + "s";
-    }
-}
-
-static float millisecondsFromString(const juce::String& text)
-{
-    float value = text.getFloatValue();
-    if (!text.endsWithIgnoreCase("ms")) {
-        if (text.endsWithIgnoreCase("s") || value < Parameters::minDelayTime) {
-            return value * 1000.0f;
-        }
-    }
-    return value;
-}
-
-static juce::String stringFromDecibels(float value, int) {
-    return juce::String(value, 1) + "dB";
-}
-
-static juce::String stringFromPercent(float value, int) {
-    return juce::String(int(value)) + " %";
-}
-
-static juce::String stringFromBool(bool value, int) {
-    return value ? juce::String("On") : juce::String("Off");
-}
-
-static juce::String stringFromHz(float value, int) {
-    if (value < 1000.0f) {
-        return juce::String(int(value)) + "Hz";
-    } else if (value < 10000.0f) {
-        return juce::String(value / 1000.0f, 2) + "kHz";
-    } else {
-        return juce::String(value / 10000.0f, 1) + "kHz";
-    }
-}
-
-static float hzFromString(const juce::String& text) {
-    float value = text.getFloatValue();
-    if (value < 20.0f || text.endsWithIgnoreCase("k") || text.endsWithIgnoreCase("kHz")) {
-        return value * 1000.0f;
-    }
-    return value;
-}
-
-// Constructor
-Parameters::Parameters(juce::AudioProcessorValueTreeState& apvts)
-{
-    castParameter(apvts, ParamIDs::gain, gainParam);
-    castParameter(apvts, ParamIDs::delayTime, delayTimeParam);
-    castParameter(apvts, ParamIDs::mix, mixParam);
-    castParameter(apvts, ParamIDs::feedback, feedbackParam);
-    castParameter(apvts, ParamIDs::flipFlop, flipFlopParam);
-    castParameter(apvts, ParamIDs::lowCut, lowCutParam);
-    castParameter(apvts, ParamIDs::highCut, highCutParam);
-    castParameter(apvts, ParamIDs::accelerateMode, accelerateModeParam);
-    castParameter(apvts, ParamIDs::decelerateMode, decelerateModeParam);
-    castParameter(apvts, ParamIDs::tempoSync, tempoSyncParam);
-    castParameter(apvts, ParamIDs::delayNote, delayNoteParam);
-    castParameter(apvts, ParamIDs::bypass, bypassParam);
-}
-
-juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createParameterLayout() {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-    
-    // Gain parameter
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-               //parameter ID
-               ParamIDs::gain,
-               //parameter display name
-               "Output Gain",
-               //min, max, step interval, skew
-               juce::NormalisableRange<float> { -60.0f, 12.0f, 0.001f, 3.8f },
-               //default value
-               0.0f,
-               //set value string display
-               juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromDecibels)));
-    
-    // Delay Time parameter
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-               //Parameter ID
-               ParamIDs::delayTime,
-               //parameter display name
-               "Delay Time",
-               //min, max, step interval, skew
-               juce::NormalisableRange<float> { minDelayTime, maxDelayTime, 0.001f, 0.35f },
-               //default value
-               100.0f,
-               //set value string display
-               juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromMilliseconds).withValueFromStringFunction(millisecondsFromString)));
-    
-    // Mix parameter
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-               //Parameter ID
-               ParamIDs::mix,
-               //parameter display name
-               "Mix",
-               //min, max, step interval, skew
-               juce::NormalisableRange<float> { 0.0f, 100.0f, 1.0f },
-               //default value
-               50.0f,
-               //set value string display
-               juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromPercent)));
-    
-    // feedback parameter
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-                //Parameter ID
-                ParamIDs::feedback,
-                "Feedback",
-                juce::NormalisableRange<float> { -105.0f, 105.0f, 1.0f },
-                0.0f,
-                juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromPercent)));
-    
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        ParamIDs::flipFlop,
-        "Flip Flop",
-        false, // default value
-        juce::AudioParameterBoolAttributes().withStringFromValueFunction(stringFromBool)
-    ));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-                 ParamIDs::lowCut,
-                 "Low Cut",
-                 juce::NormalisableRange<float> { 20.0f, 20000.0f, 1.0f, 0.3f },
-                 20.0f,
-                 juce::AudioParameterFloatAttributes()
-                     .withStringFromValueFunction(stringFromHz)
-                     .withValueFromStringFunction(hzFromString)
-               ));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-                 ParamIDs::highCut,
-                 "High Cut",
-                 juce::NormalisableRange<float> { 20.0f, 20000.0f, 1.0f, 0.3f },
-                 20000.0f,
-                 juce::AudioParameterFloatAttributes()
-                     .withStringFromValueFunction(stringFromHz)
-                     .withValueFromStringFunction(hzFromString)
-               ));
-    
-    const juce::StringArray delayModes = {
-        "Repitch",
-        "Fade",
-        "Duck",
-    };
-    
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-                ParamIDs::accelerateMode,
-                "Accelerate Mode",
-                delayModes,
-                0
-                ));
-    
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-                ParamIDs::decelerateMode,
-                "Decelerate Mode",
-                delayModes,
-                0
-                ));
-    
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-                ParamIDs::tempoSync,
-                "Tempo Sync",
-                false
-                ));
-    
-    const juce::StringArray noteLengths = {
-        "1/32",
-        "1/16 trip",
-        "1/32 dot",
-        "1/16",
-        "1/8 trip",
-        "1/16 dot",
-        "1/8",
-        "1/4 trip",
-        "1/8 dot",
-        "1/4",
-        "1/2 trip",
-        "1/4 dot",
-        "1/2",
-        "1/1 trip",
-        "1/2 dot",
-        "1/1",
-    };
-    
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-                ParamIDs::delayNote,
-                "DelayNote",
-                noteLengths,
-                9 //"1/4"
-                ));
-    
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-                ParamIDs::bypass,
-                "Bypass",
-                false
-                ));
-    
-    return layout;
-}
-
-void Parameters::prepareToPlay(double sampleRate) noexcept
-{
-    double duration = 0.02;
-    gainSmoother.reset(sampleRate, duration);
-    mixSmoother.reset(sampleRate, duration);
-    
-    coeff = 1.0f - std::exp(-1.0f / (0.2f * float(sampleRate)));
-    
-    feedbackSmoother.reset(sampleRate, duration);
-    
-    lowCutSmoother.reset(sampleRate, duration);
-    highCutSmoother.reset(sampleRate, duration);
-    invertStereoSmoother.reset(sampleRate, duration);
-}
-
-void Parameters::reset() noexcept
-{
-    gain = 0.0f;
-    gainSmoother.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(gainParam->get()));
-    
-    delayTime = 0.0f;
-    delayNote = 9;
-    
-    mix = 50.0f;
-    mixSmoother.setCurrentAndTargetValue(mixParam->get() * 0.01f);
-    
-    feedback = 0.0f;
-    feedbackSmoother.setCurrentAndTargetValue(feedbackParam->get() * 0.01f);
-    
-    flipFlop = false;
-    invertStereo = 0.0f;
-    invertStereoSmoother.setCurrentAndTargetValue(invertStereo);
-    
-    lowCut = 0.0f;
-    lowCutSmoother.setCurrentAndTargetValue(lowCutParam->get());
-    
-    highCut = 0.0f;
-    highCutSmoother.setCurrentAndTargetValue(highCutParam->get());
-    
-    accelerateMode = 0;
-    decelerateMode = 0;
-}
-
-void Parameters::update() noexcept
-{
-    gainSmoother.setTargetValue(juce::Decibels::decibelsToGain(gainParam->get()));
-    
-    targetDelayTime = delayTimeParam->get();
-    if (delayTime == 0.0f) {
-        delayTime = targetDelayTime;
-    }
-    
-    accelerateMode = accelerateModeParam->getIndex();
-    decelerateMode = decelerateModeParam->getIndex();
-    
-    mixSmoother.setTargetValue(mixParam->get() * 0.01f);
-    
-    feedbackSmoother.setTargetValue(feedbackParam->get() * 0.01f);
-    
-    lowCutSmoother.setTargetValue(lowCutParam->get());
-    highCutSmoother.setTargetValue(highCutParam->get());
-    
-    invertStereoSmoother.setTargetValue(flipFlopParam->get() ? 1.0f : 0.0f);
-    
-    delayNote = delayNoteParam->getIndex();
-    tempoSync = tempoSyncParam->get();
-    
-    bypass = bypassParam->get();
-}
-
-void Parameters::smoothen() noexcept
-{
-    gain = gainSmoother.getNextValue();
-    
-    delayTime = getSmoothenedDelayTime();
-    
-    mix = mixSmoother.getNextValue();
-    
-    feedback = feedbackSmoother.getNextValue();
-    
-    lowCut = lowCutSmoother.getNextValue();
-    highCut = highCutSmoother.getNextValue();
-    
-    invertStereo = invertStereoSmoother.getNextValue();
-}
-
-float Parameters::getSmoothenedDelayTime() noexcept
-{
-    updateShiftMode();
-    if (shiftMode == ShiftMode::REPITCH) {
-        return delayTime + (targetDelayTime - delayTime) * coeff;
-    } else {
-        return delayTime = targetDelayTime;
-    }
-}
-
-ShiftMode Parameters::determineShiftMode(const juce::AudioPlayHead *playhead) noexcept
-{
-    if (playhead == nullptr) { return shiftMode; }
-    
-    const auto opt = playhead->getPosition();
-    
-    if (!opt.hasValue()) { return shiftMode; }
-    
-    const auto& pos = *opt;
-    
-    if (pos.getTimeInSamples().hasValue()) {
-        timeInSamples = *pos.getTimeInSamples();
-    }
-    
-    if (timeInSamples < lastTimeInSamples) {
-        return ShiftMode::DUCK;
-        // when looping, minimize unexpected artifacts by temporarily switching to duck mode
-    }
-    
-    return shiftMode;
-}
-
-void Parameters::updateShiftMode() noexcept
-{
-    if (!tempoSync) {
-        if (targetDelayTime < delayTime) { // accelerating, get the acceleration mode
-            shiftMode = static_cast<ShiftMode>(accelerateMode);
-        }
-        else if (targetDelayTime > delayTime) { // decelerating, get the deceleration mode
-            shiftMode = static_cast<ShiftMode>(decelerateMode);
-        }
-    } else {
-        if (delayNote == lastDelayNote) {
-            return;
-        } else {
-            bool isFaster = delayNote < lastDelayNote;
-            lastDelayNote = delayNote;
-            shiftMode = static_cast<ShiftMode>(isFaster ? accelerateMode : decelerateMode);
-        }
-    }
-    
-    
-    // no update is required: once the delay time stops moving, the mode can stay where it was set
-}
+/*
+  ==============================================================================
+
+    Parameters.cpp
+    Created: 26 Apr 2025 3:11:09pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "Parameters.h"
+#include "DSP.h"
+#include "Trace.h"
+
+// Helper function to cast Parameter values to usable types
+template<typename T> static void castParameter(juce::AudioProcessorValueTreeState& apvts,
+                                               const juce::ParameterID& id, T& destination)
+{
+    destination = dynamic_cast<T>(apvts.getParameter(id.getParamID()));
+    jassert(destination); // parameter does not exist or wrong type
+}
+
+static juce::String stringFromMilliseconds(float value, int)
+{
+    if (value < 10.0f) {
+        return juce::String(value, 2) + "ms";
+    } else if (value < 100.f) {
+        return juce::String(value, 1) + "ms";
+    } else if (value < 1000.0f) {
+        return juce::String(int(value)) + "ms";
+    } else {
+        return juce::String(value * 0.001f, 2) + "s";
+    }
+}
+
+static float millisecondsFromString(const juce::String& text)
+{
+    float value = text.getFloatValue();
+    if (!text.endsWithIgnoreCase("ms")) {
+        if (text.endsWithIgnoreCase("s") || value < Parameters::minDelayTime) {
+            return value * 1000.0f;
+        }
+    }
+    return value;
+}
+
+static juce::String stringFromDecibels(float value, int) {
+    return juce::String(value, 1) + "dB";
+}
+
+static juce::String stringFromPercent(float value, int) {
+    return juce::String(int(value)) + " %";
+}
+
+static juce::String stringFromBool(bool value, int) {
+    return value ? juce::String("On") : juce::String("Off");
+}
+
+static juce::String stringFromHz(float value, int) {
+    if (value < 1000.0f) {
+        return juce::String(int(value)) + "Hz";
+    } else if (value < 10000.0f) {
+        return juce::String(value / 1000.0f, 2) + "kHz";
+    } else {
+        return juce::String(value / 10000.0f, 1) + "kHz";
+    }
+}
+
+static float hzFromString(const juce::String& text) {
+    float value = text.getFloatValue();
+    if (value < 20.0f || text.endsWithIgnoreCase("k") || text.endsWithIgnoreCase("kHz")) {
+        return value * 1000.0f;
+    }
+    return value;
+}
+
+// The range and default of a delay parameter are the engine's, the step and skew the knob's
+static juce::NormalisableRange<float> rangeOf(int parameter, float interval, float skew = 1.0f)
+{
+    const auto& info = DelayEngine::getParameterInfo(parameter);
+    return { info.minimum, info.maximum, interval, skew };
+}
+
+static float defaultOf(int parameter)
+{
+    return DelayEngine::getParameterInfo(parameter).defaultValue;
+}
+
+// Constructor
+Parameters::Parameters(juce::AudioProcessorValueTreeState& apvts)
+{
+    castParameter(apvts, ParamIDs::gain, gainParam);
+    castParameter(apvts, ParamIDs::delayTime, delayTimeParam);
+    castParameter(apvts, ParamIDs::mix, mixParam);
+    castParameter(apvts, ParamIDs::feedback, feedbackParam);
+    castParameter(apvts, ParamIDs::flipFlop, flipFlopParam);
+    castParameter(apvts, ParamIDs::lowCut, lowCutParam);
+    castParameter(apvts, ParamIDs::highCut, highCutParam);
+    castParameter(apvts, ParamIDs::accelerateMode, accelerateModeParam);
+    castParameter(apvts, ParamIDs::decelerateMode, decelerateModeParam);
+    castParameter(apvts, ParamIDs::tempoSync, tempoSyncParam);
+    castParameter(apvts, ParamIDs::delayNote, delayNoteParam);
+    castParameter(apvts, ParamIDs::bypass, bypassParam);
+    castParameter(apvts, ParamIDs::truePeak, truePeakParam);
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createParameterLayout() {
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+    
+    // Gain parameter
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+               //parameter ID
+               ParamIDs::gain,
+               //parameter display name
+               "Output Gain",
+               //step interval, skew
+               rangeOf(DelayEngine::gain, 0.001f, 3.8f),
+               //default value
+               defaultOf(DelayEngine::gain),
+               //set value string display
+               juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromDecibels)));
+    
+    // Delay Time parameter
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+               //Parameter ID
+               ParamIDs::delayTime,
+               //parameter display name
+               "Delay Time",
+               //step interval, skew
+               rangeOf(DelayEngine::delayTime, 0.001f, 0.35f),
+               //default value
+               defaultOf(DelayEngine::delayTime),
+               //set value string display
+               juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromMilliseconds).withValueFromStringFunction(millisecondsFromString)));
+    
+    // Mix parameter
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+               //Parameter ID
+               ParamIDs::mix,
+               //parameter display name
+               "Mix",
+               //step interval
+               rangeOf(DelayEngine::mix, 1.0f),
+               //default value
+               defaultOf(DelayEngine::mix),
+               //set value string display
+               juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromPercent)));
+    
+    // feedback parameter
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+                //Parameter ID
+                ParamIDs::feedback,
+                "Feedback",
+                rangeOf(DelayEngine::feedback, 1.0f),
+                defaultOf(DelayEngine::feedback),
+                juce::AudioParameterFloatAttributes().withStringFromValueFunction(stringFromPercent)));
+    
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        ParamIDs::flipFlop,
+        "Flip Flop",
+        defaultOf(DelayEngine::flipFlop) != 0.0f,
+        juce::AudioParameterBoolAttributes().withStringFromValueFunction(stringFromBool)
+    ));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+                 ParamIDs::lowCut,
+                 "Low Cut",
+                 rangeOf(DelayEngine::lowCut, 1.0f, 0.3f),
+                 defaultOf(DelayEngine::lowCut),
+                 juce::AudioParameterFloatAttributes()
+                     .withStringFromValueFunction(stringFromHz)
+                     .withValueFromStringFunction(hzFromString)
+               ));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+                 ParamIDs::highCut,
+                 "High Cut",
+                 rangeOf(DelayEngine::highCut, 1.0f, 0.3f),
+                 defaultOf(DelayEngine::highCut),
+                 juce::AudioParameterFloatAttributes()
+                     .withStringFromValueFunction(stringFromHz)
+                     .withValueFromStringFunction(hzFromString)
+               ));
+    
+    const juce::StringArray delayModes = {
+        "Repitch",
+        "Fade",
+        "Duck",
+    };
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+                ParamIDs::accelerateMode,
+                "Accelerate Mode",
+                delayModes,
+                int(defaultOf(DelayEngine::accelerateMode))
+                ));
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+                ParamIDs::decelerateMode,
+                "Decelerate Mode",
+                delayModes,
+                int(defaultOf(DelayEngine::decelerateMode))
+                ));
+    
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+                ParamIDs::tempoSync,
+                "Tempo Sync",
+                defaultOf(DelayEngine::tempoSync) != 0.0f
+                ));
+    
+    const juce::StringArray noteLengths = {
+        "1/32",
+        "1/16 trip",
+        "1/32 dot",
+        "1/16",
+        "1/8 trip",
+        "1/16 dot",
+        "1/8",
+        "1/4 trip",
+        "1/8 dot",
+        "1/4",
+        "1/2 trip",
+        "1/4 dot",
+        "1/2",
+        "1/1 trip",
+        "1/2 dot",
+        "1/1",
+    };
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+                ParamIDs::delayNote,
+                "DelayNote",
+                noteLengths,
+                int(defaultOf(DelayEngine::delayNote)) //"1/4"
+                ));
+    
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+                ParamIDs::bypass,
+                "Bypass",
+                false
+                ));
+    
+    // switches the output meter to 4x oversampled true peak, off it costs nothing
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+                ParamIDs::truePeak,
+                "True Peak Meter",
+                false,
+                juce::AudioParameterBoolAttributes()
+                    .withStringFromValueFunction(stringFromBool)
+                    .withAutomatable(false)
+                ));
+    
+    return layout;
+}
+
+void Parameters::update(DelayEngine& engine) noexcept
+{
+    BROCDELAY_TRACE_SCOPE("Parameters::update");
+    
+    engine.setParameter(DelayEngine::gain, gainParam->get());
+    engine.setParameter(DelayEngine::delayTime, delayTimeParam->get());
+    engine.setParameter(DelayEngine::mix, mixParam->get());
+    engine.setParameter(DelayEngine::feedback, feedbackParam->get());
+    engine.setParameter(DelayEngine::flipFlop, flipFlopParam->get() ? 1.0f : 0.0f);
+    engine.setParameter(DelayEngine::lowCut, lowCutParam->get());
+    engine.setParameter(DelayEngine::highCut, highCutParam->get());
+    engine.setParameter(DelayEngine::accelerateMode, float(accelerateModeParam->getIndex()));
+    engine.setParameter(DelayEngine::decelerateMode, float(decelerateModeParam->getIndex()));
+    engine.setParameter(DelayEngine::tempoSync, tempoSyncParam->get() ? 1.0f : 0.0f);
+    engine.setParameter(DelayEngine::delayNote, float(delayNoteParam->getIndex()));
+    
+    bypass = bypassParam->get();
+    
+    truePeak = truePeakParam->get();
+}
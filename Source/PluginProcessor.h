@@ -1,103 +1,139 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "Parameters.h"
-#include "Tempo.h"
-#include "DelayLine.h"
-#include "Measurement.h"
-
-//==============================================================================
-/**
-*/
-class DelayAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    //==============================================================================
-    DelayAudioProcessor();
-    ~DelayAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-    
-    //==============================================================================
-    juce::AudioProcessorValueTreeState apvts {
-        *this, nullptr, "Parameters", Parameters::createParameterLayout()
-    };
-    
-    Parameters params;
-    
-    Measurement levelL, levelR;
-
-private:
-    //==============================================================================
-    DelayLine delayLineL, delayLineR;
-    
-    float feedbackL = 0.0f;
-    float feedbackR = 0.0f;
-    
-    juce::dsp::StateVariableTPTFilter<float> lowCutFilter;
-    juce::dsp::StateVariableTPTFilter<float> highCutFilter;
-    
-    float lastLowCut = -1.0f;
-    float lastHighCut = -1.0f;
-    
-    float lastMix = -1.0f;
-    float dryGain = 1.0f;
-    float wetGain = 0.0f;
-    
-    Tempo tempo;
-    
-    float delayInSamples = 0.0f;
-    float targetDelay = 0.0f;
-    
-    float xfade = 0.0f;
-    float xfadeInc = 0.0f;
-    
-    float duckFade = 0.0f;
-    float duckFadeTarget = 0.0f;
-    float duckCoeff = 0.0f;
-    float duckWait = 0.0f;
-    float duckWaitInc = 0.0f;
-    
-    float tempoSyncCoeff = 0.0f;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Parameters.h"
+#include "Tempo.h"
+#include "DelayEngine.h"
+#include "BlockStats.h"
+#include "EchoPoints.h"
+#include "WetSamples.h"
+#include "LoadHistogram.h"
+#include "Trace.h"
+#include "AutomationLog.h"
+
+//==============================================================================
+/**
+*/
+class DelayAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    //==============================================================================
+    DelayAudioProcessor();
+    ~DelayAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+    
+    // How long the echoes take to die away with the current parameters and tempo, infinite with
+    // feedback at 100% or more. Hosts are told at most maxReportedTail of it, renders like
+    // BatchRender that want all of it ask here.
+    double getEchoTailSeconds() const;
+    static constexpr double maxReportedTail = 30.0;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+    
+    //==============================================================================
+   #if BROCDELAY_TRACE
+    // first, so it outlives everything that records into the trace
+    Trace::Session traceSession;
+   #endif
+    
+    juce::AudioProcessorValueTreeState apvts {
+        *this, nullptr, "Parameters", Parameters::createParameterLayout()
+    };
+    
+    Parameters params;
+    
+    // one record per processBlock call, read by the editor
+    BlockStatsQueue blockStats;
+    
+    // the decimated wet signal, read by the editor's echo display
+    EchoQueue echoPoints;
+    
+    // the wet signal itself, read by the spectrum analyzer
+    WetSampleQueue wetSamplesL;
+    WetSampleQueue wetSamplesR;
+    
+   #if BROCDELAY_LOAD_METER
+    // processBlock's share of the real-time budget, block by block, read by the editor's load meter
+    LoadHistogram loadHistogram;
+   #endif
+
+private:
+    //==============================================================================
+    // The delay itself. processBlock hands it the parameters and the host's transport, lets it
+    // render, and measures the result for the meters and displays.
+    DelayEngine engine;
+    
+    Tempo tempo;
+    
+   #if BROCDELAY_AUTOMATION_CAPTURE
+    // what the host automated, for ProcessBlockBenchmark --replay
+    AutomationLog::Recorder automationLog;
+   #endif
+    
+    // output of the current segment with the last DSPKernels::truePeakHistory samples of the
+    // previous one in front, for the true peak kernel
+    juce::AudioBuffer<float> truePeakBuffer;
+    float measureTruePeak(int channel, const float* output, int numSamples) noexcept;
+    
+    // Adds the wet signal of the current segment to echoPoints
+    void summarizeEcho(int numSamples) noexcept;
+    
+    // What the meters and displays carry over from one block to the next
+    struct DisplayState
+    {
+        // samples processed since prepareToPlay, for BlockStats::samplePosition
+        int64_t samplePosition = 0;
+        
+        // whether truePeakBuffer holds the history of the previous block
+        bool truePeakPrimed = false;
+        
+        // the EchoPoint being collected, it may span several blocks
+        int echoSamplesPerPoint = 1;
+        int echoSampleCount = 0;
+        float echoMin = 0.0f;
+        float echoMax = 0.0f;
+        float inverseSampleRate = 0.0f;
+    };
+    
+    DisplayState state;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayAudioProcessor)
+};
@@ -0,0 +1,353 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.cpp
+    Created: 19 Oct 2026 1:06:38am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "RealtimeCheck.h"
+
+// Nothing at all unless the build asked for it
+#if BROCDELAY_REALTIME_CHECK
+
+#if defined(_WIN32)
+ #error "RealtimeCheck needs a POSIX system"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <new>
+#include <string>
+#include <stdlib.h>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+ #include <execinfo.h>
+ #define BROCDELAY_REALTIME_CHECK_STACKS 1
+#else
+ #define BROCDELAY_REALTIME_CHECK_STACKS 0
+#endif
+
+#if defined(__GLIBC__)
+ #include <dlfcn.h>
+ #include <pthread.h>
+
+// glibc's own allocator, under the names it exports for exactly this
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+}
+#endif
+
+namespace RealtimeCheck
+{
+
+namespace
+{
+    constexpr int maxViolations = 64;
+    constexpr int maxFrames = 32;
+
+    // check() itself, the replaced function stays in the stack to show what was called
+    constexpr int skippedFrames = 1;
+
+    struct Violation
+    {
+        const char* what;
+        int numFrames;
+        void* frames[maxFrames];
+        std::atomic<bool> ready { false };
+    };
+
+    Violation violations[maxViolations];
+    std::atomic<int> numViolations { 0 };
+
+    // Plain values, so using them from inside malloc can't allocate
+    thread_local int scopeDepth = 0;
+    thread_local bool recording = false;
+
+   #if BROCDELAY_REALTIME_CHECK_STACKS
+    // The first backtrace() loads the unwinder, which allocates. Better here than in a scope.
+    [[maybe_unused]] const bool unwinderLoaded = [] {
+        void* frame;
+        return backtrace(&frame, 1) >= 0;
+    }();
+   #endif
+
+    __attribute__((noinline)) void check(const char* what) noexcept
+    {
+        if (scopeDepth == 0 || recording) {
+            return;
+        }
+        recording = true;
+
+        int index = numViolations.fetch_add(1, std::memory_order_relaxed);
+        if (index < maxViolations) {
+            auto& violation = violations[index];
+            violation.what = what;
+           #if BROCDELAY_REALTIME_CHECK_STACKS
+            violation.numFrames = backtrace(violation.frames, maxFrames);
+           #else
+            violation.numFrames = 0;
+           #endif
+            violation.ready.store(true, std::memory_order_release);
+        }
+
+        recording = false;
+    }
+
+    void* rawMalloc(size_t size) noexcept
+    {
+       #if defined(__GLIBC__)
+        return __libc_malloc(size);
+       #else
+        return std::malloc(size);
+       #endif
+    }
+
+    void* rawAlignedMalloc(size_t alignment, size_t size) noexcept
+    {
+       #if defined(__GLIBC__)
+        return __libc_memalign(alignment, size);
+       #else
+        void* pointer = nullptr;
+        return posix_memalign(&pointer, std::max(alignment, sizeof(void*)), size) == 0 ? pointer : nullptr;
+       #endif
+    }
+
+    void rawFree(void* pointer) noexcept
+    {
+       #if defined(__GLIBC__)
+        __libc_free(pointer);
+       #else
+        std::free(pointer);
+       #endif
+    }
+
+    bool isSameStack(const Violation& a, const Violation& b) noexcept
+    {
+        return a.what == b.what
+            && a.numFrames == b.numFrames
+            && std::memcmp(a.frames, b.frames, sizeof(void*) * size_t(a.numFrames)) == 0;
+    }
+
+    void printStack(std::FILE* file, const Violation& violation)
+    {
+       #if BROCDELAY_REALTIME_CHECK_STACKS
+        char** symbols = backtrace_symbols(violation.frames, violation.numFrames);
+        for (int i = skippedFrames; i < violation.numFrames; ++i) {
+            std::string line = symbols != nullptr ? symbols[i] : "?";
+
+            // the mangled name sits between "(" and "+" (glibc) or spaces (macOS)
+            auto begin = line.find("_Z");
+            if (begin != std::string::npos) {
+                auto end = line.find_first_of("+ )", begin);
+                auto length = (end == std::string::npos ? line.size() : end) - begin;
+                int status = 0;
+                char* name = abi::__cxa_demangle(line.substr(begin, length).c_str(), nullptr, nullptr, &status);
+                if (status == 0 && name != nullptr) {
+                    line.replace(begin, length, name);
+                }
+                std::free(name);
+            }
+            std::fprintf(file, "        %s\n", line.c_str());
+        }
+        std::free(symbols);
+       #else
+        (void) violation;
+        std::fprintf(file, "        (no stacks on this platform)\n");
+       #endif
+    }
+}
+
+Scope::Scope(bool enabled_) noexcept : enabled(enabled_)
+{
+    if (enabled) {
+        scopeDepth += 1;
+    }
+}
+
+Scope::~Scope()
+{
+    if (enabled) {
+        scopeDepth -= 1;
+    }
+}
+
+int getNumViolations() noexcept
+{
+    return numViolations.load(std::memory_order_relaxed);
+}
+
+int report(std::FILE* file, const char* title)
+{
+    int total = numViolations.load(std::memory_order_acquire);
+    if (total == 0) {
+        return 0;
+    }
+    int numKept = std::min(total, maxViolations);
+
+    std::fprintf(file, "%s: %d real-time violation%s\n", title, total, total == 1 ? "" : "s");
+
+    bool printed[maxViolations] = {};
+    for (int i = 0; i < numKept; ++i) {
+        if (printed[i] || !violations[i].ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        int count = 0;
+        for (int j = i; j < numKept; ++j) {
+            if (!printed[j] && violations[j].ready.load(std::memory_order_acquire)
+                    && isSameStack(violations[i], violations[j])) {
+                printed[j] = true;
+                count += 1;
+            }
+        }
+        std::fprintf(file, "    %dx %s\n", count, violations[i].what);
+        printStack(file, violations[i]);
+    }
+    if (total > numKept) {
+        std::fprintf(file, "    and %d more that weren't kept\n", total - numKept);
+    }
+    std::fflush(file);
+
+    for (auto& violation : violations) {
+        violation.ready.store(false, std::memory_order_relaxed);
+    }
+    numViolations.store(0, std::memory_order_release);
+    return total;
+}
+
+}  // namespace RealtimeCheck
+
+// The replacements. They record, then do what they'd have done anyway. The array forms of new
+// and delete are left to the standard library, which forwards them to these.
+
+void* operator new(size_t size)
+{
+    RealtimeCheck::check("operator new");
+    if (void* pointer = RealtimeCheck::rawMalloc(size > 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeCheck::check("operator new");
+    return RealtimeCheck::rawMalloc(size > 0 ? size : 1);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    RealtimeCheck::check("operator new (aligned)");
+    if (void* pointer = RealtimeCheck::rawAlignedMalloc(size_t(alignment), size > 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    RealtimeCheck::check("operator new (aligned)");
+    return RealtimeCheck::rawAlignedMalloc(size_t(alignment), size > 0 ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer != nullptr) {
+        RealtimeCheck::check("operator delete");
+    }
+    RealtimeCheck::rawFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    if (pointer != nullptr) {
+        RealtimeCheck::check("operator delete (aligned)");
+    }
+    RealtimeCheck::rawFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+
+void* malloc(size_t size) noexcept
+{
+    RealtimeCheck::check("malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept
+{
+    RealtimeCheck::check("calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept
+{
+    RealtimeCheck::check("realloc");
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer) noexcept
+{
+    if (pointer != nullptr) {
+        RealtimeCheck::check("free");
+    }
+    __libc_free(pointer);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    RealtimeCheck::check("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pointer, size_t alignment, size_t size) noexcept
+{
+    RealtimeCheck::check("posix_memalign");
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer != nullptr ? 0 : ENOMEM;
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+{
+    RealtimeCheck::check("pthread_mutex_lock");
+
+    using Lock = int (*)(pthread_mutex_t*);
+    static std::atomic<Lock> realLock { nullptr };
+    auto lock = realLock.load(std::memory_order_relaxed);
+    if (lock == nullptr) {
+        lock = reinterpret_cast<Lock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        realLock.store(lock, std::memory_order_relaxed);
+    }
+    return lock(mutex);
+}
+
+}  // extern "C"
+#endif
+
+#endif  // BROCDELAY_REALTIME_CHECK
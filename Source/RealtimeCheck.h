@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.h
+    Created: 19 Oct 2026 1:06:38am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdio>
+
+// Test builds of the headless tools define this as 1 (cmake -DBROCDELAY_REALTIME_CHECK=ON).
+// Never in the plugin: it replaces malloc and friends for the whole process.
+#ifndef BROCDELAY_REALTIME_CHECK
+ #define BROCDELAY_REALTIME_CHECK 0
+#endif
+
+// Catches the audio thread doing what it must never do. While a Scope is alive on a thread,
+// every operator new / delete, malloc / calloc / realloc / free, aligned allocation and
+// pthread_mutex_lock on that thread is recorded as a violation together with its stack, and
+// then goes ahead as usual. MessageManager::callAsync, String building, growing an Array or
+// locking a CriticalSection all end up in one of those.
+//
+// operator new and delete are replaced everywhere, the C functions only with glibc, where they
+// can be forwarded to __libc_malloc and friends. Stacks need <execinfo.h> (glibc, macOS).
+// Recording doesn't allocate or lock itself: the first violations are kept in a fixed table,
+// the rest are only counted.
+namespace RealtimeCheck
+{
+    class Scope
+    {
+    public:
+        // enabled is false where blocking is fine after all, e.g. while the host is bouncing
+        explicit Scope(bool enabled = true) noexcept;
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool enabled;
+    };
+
+    // How many violations there have been since the last report()
+    int getNumViolations() noexcept;
+
+    // Writes the violations since the last report() to file, identical stacks once with a
+    // count, and starts counting from zero again. Returns how many there were. Call it when no
+    // Scope is alive; it isn't real-time safe.
+    int report(std::FILE* file, const char* title);
+}
+
+#if BROCDELAY_REALTIME_CHECK
+ #define BROCDELAY_REALTIME_SCOPE(enabled) RealtimeCheck::Scope realtimeCheckScope { enabled }
+#else
+ #define BROCDELAY_REALTIME_SCOPE(enabled)
+#endif
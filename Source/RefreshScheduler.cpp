@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.cpp
+    Created: 18 Oct 2026 6:02:19pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "RefreshScheduler.h"
+#include "Trace.h"
+
+RefreshScheduler::RefreshScheduler()
+{
+    lastFrameTime = juce::Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+RefreshScheduler::~RefreshScheduler()
+{
+    jassert(entries.empty()); // a client forgot to remove itself
+}
+
+void RefreshScheduler::add(juce::Component& component, Client& client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    entries.push_back({ &component, &client });
+    
+    if (vBlankComponent == nullptr) {
+        attachToShowingComponent();
+    }
+    if (!isTimerRunning()) {
+        startTimerHz(watchdogRate);
+    }
+}
+
+void RefreshScheduler::remove(Client& client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    bool wasDriving = false;
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->client == &client) {
+            wasDriving = wasDriving || it->component == vBlankComponent;
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    // don't hand out a client that's on its way out in the frame that's running right now
+    for (auto& entry : entriesThisFrame) {
+        if (entry.client == &client) {
+            entry.client = nullptr;
+        }
+    }
+    
+    if (wasDriving) {
+        vBlank = {};
+        vBlankComponent = nullptr;
+        attachToShowingComponent();
+    }
+    if (entries.empty()) {
+        stopTimer();
+        fallbackActive = false;
+    }
+}
+
+void RefreshScheduler::attachToShowingComponent()
+{
+    for (auto& entry : entries) {
+        if (entry.component->isShowing()) {
+            if (entry.component != vBlankComponent) {
+                vBlankComponent = entry.component;
+                vBlank = juce::VBlankAttachment(vBlankComponent, [this] { vBlankCallback(); });
+            }
+            return;
+        }
+    }
+}
+
+void RefreshScheduler::vBlankCallback()
+{
+    if (fallbackActive) {
+        fallbackActive = false;
+        startTimerHz(watchdogRate);
+    }
+    frame();
+}
+
+void RefreshScheduler::timerCallback()
+{
+    // Normally the vblanks keep lastFrameTime fresh and this does nothing. If they went quiet,
+    // try another component and keep things moving in the meantime.
+    double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    if (!fallbackActive && now - lastFrameTime <= frameTimeout) {
+        return;
+    }
+    
+    // with every editor hidden there is nothing to draw, so go back to checking slowly
+    attachToShowingComponent();
+    bool anythingShowing = frame();
+    if (anythingShowing != fallbackActive) {
+        fallbackActive = anythingShowing;
+        startTimerHz(fallbackActive ? fallbackRate : watchdogRate);
+    }
+}
+
+bool RefreshScheduler::frame()
+{
+    BROCDELAY_TRACE_SCOPE("RefreshScheduler::frame");
+    BROCDELAY_TRACE_THREAD_NAME("Message");
+    
+    double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    double elapsed = std::min(now - lastFrameTime, frameTimeout);
+    lastFrameTime = now;
+    
+    // a client may add or remove others (or itself) from its callback
+    entriesThisFrame = entries;
+    bool anythingShowing = false;
+    for (auto& entry : entriesThisFrame) {
+        if (entry.client != nullptr && entry.component->isShowing()) {
+            entry.client->refresh(elapsed);
+            anythingShowing = true;
+        }
+    }
+    entriesThisFrame.clear();
+    return anythingShowing;
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.h
+    Created: 18 Oct 2026 6:02:19pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One frame callback for every animated component in the process (meters and future
+// visualisers), instead of a juce::Timer per component per editor waking the message thread
+// out of phase. Hold it with a juce::SharedResourcePointer<RefreshScheduler>; it lives as long
+// as anybody uses it.
+//
+// Frames come from a juce::VBlankAttachment on one of the showing components, so they follow
+// the display. A slow watchdog timer takes over at the usual 60 Hz if they stop (e.g. the window
+// with that component got minimised while others are still open), and hands back as soon as
+// the vblanks return. Clients whose component isn't showing are skipped.
+class RefreshScheduler : private juce::Timer
+{
+public:
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        
+        // Called once per frame on the message thread with the time since the previous frame
+        virtual void refresh(double elapsedSeconds) = 0;
+    };
+    
+    RefreshScheduler();
+    ~RefreshScheduler() override;
+    
+    // Call from the message thread. The client must be removed before it or its component
+    // is deleted.
+    void add(juce::Component& component, Client& client);
+    void remove(Client& client);
+    
+private:
+    void timerCallback() override;
+    void vBlankCallback();
+    bool frame(); // returns false if no client was showing
+    void attachToShowingComponent();
+    
+    struct Entry
+    {
+        juce::Component* component;
+        Client* client;
+    };
+    
+    std::vector<Entry> entries;
+    std::vector<Entry> entriesThisFrame;
+    
+    juce::VBlankAttachment vBlank;
+    juce::Component* vBlankComponent = nullptr;
+    
+    double lastFrameTime = 0.0;
+    
+    // how long without a vblank before the timer steps in, how often it checks for that, and
+    // how fast it runs once it has taken over
+    static constexpr double frameTimeout = 0.1;
+    static constexpr int watchdogRate = 10;
+    static constexpr int fallbackRate = 60;
+    bool fallbackActive = false;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RefreshScheduler)
+};
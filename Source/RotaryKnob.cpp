@@ -1,68 +1,68 @@
-/*
-  ==============================================================================
-
-    RotaryKnob.cpp
-    Created: 29 Apr 2025 5:14:16pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "RotaryKnob.h"
-#include "LookAndFeel.h"
-
-//==============================================================================
-RotaryKnob::RotaryKnob(const juce::String& text, juce::AudioProcessorValueTreeState& apvts, const juce::ParameterID& parameterID, const juce::String& tooltipText, bool drawFromMiddle)
-    : attachment(apvts, parameterID.getParamID(), slider),
-      tooltipString(tooltipText)
-{
-    // In your constructor, you should add any child components, and
-    // initialise any special settings that your component needs.
-    slider.setSliderStyle(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag);
-    slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 70, 16);
-    slider.setBounds(0,0,70,86);
-    addAndMakeVisible(slider);
-    
-    label.setText(text, juce::NotificationType::dontSendNotification);
-    label.setJustificationType(juce::Justification::horizontallyCentred);
-    label.setBorderSize(juce::BorderSize<int>{ 0, 0 , 2, 0 });
-    label.attachToComponent(&slider, false);
-    addAndMakeVisible(label);
-    
-    float pi = juce::MathConstants<float>::pi;
-    slider.setRotaryParameters(1.25f * pi, 2.75f * pi, true);
-    
-    setLookAndFeel(RotaryKnobLookAndFeel::get());
-    slider.getProperties().set("drawFromMiddle", drawFromMiddle);
-    
-    addMouseListener(this, true);
-    
-    setSize(70, 110);
-    
-}
-
-RotaryKnob::~RotaryKnob()
-{
-}
-
-void RotaryKnob::resized()
-{
-    // This method is where you should set the bounds of any child
-    // components that your component contains..
-    
-    slider.setTopLeftPosition(0, 24);
-
-}
-
-void RotaryKnob::mouseEnter(const juce::MouseEvent &event) {
-    DBG(tooltipString);
-    if (onHover)
-        onHover(tooltipString); // Pass the tooltip to whoever is listening
-}
-
-void RotaryKnob::mouseExit(const juce::MouseEvent &event) {
-//    DBG(tooltipString);
-    if (onHover)
-        onHover("");
-}
+/*
+  ==============================================================================
+
+    RotaryKnob.cpp
+    Created: 29 Apr 2025 5:14:16pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RotaryKnob.h"
+#include "LookAndFeel.h"
+
+//==============================================================================
+RotaryKnob::RotaryKnob(const juce::String& text, juce::AudioProcessorValueTreeState& apvts, const juce::ParameterID& parameterID, const juce::String& tooltipText, bool drawFromMiddle)
+    : attachment(apvts, parameterID.getParamID(), slider),
+      tooltipString(tooltipText)
+{
+    // In your constructor, you should add any child components, and
+    // initialise any special settings that your component needs.
+    slider.setSliderStyle(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag);
+    slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 70, 16);
+    slider.setBounds(0,0,70,86);
+    addAndMakeVisible(slider);
+    
+    label.setText(text, juce::NotificationType::dontSendNotification);
+    label.setJustificationType(juce::Justification::horizontallyCentred);
+    label.setBorderSize(juce::BorderSize<int>{ 0, 0 , 2, 0 });
+    label.attachToComponent(&slider, false);
+    addAndMakeVisible(label);
+    
+    float pi = juce::MathConstants<float>::pi;
+    slider.setRotaryParameters(1.25f * pi, 2.75f * pi, true);
+    
+    setLookAndFeel(RotaryKnobLookAndFeel::get());
+    slider.getProperties().set("drawFromMiddle", drawFromMiddle);
+    
+    addMouseListener(this, true);
+    
+    setSize(70, 110);
+    
+}
+
+RotaryKnob::~RotaryKnob()
+{
+}
+
+void RotaryKnob::resized()
+{
+    // This method is where you should set the bounds of any child
+    // components that your component contains..
+    
+    slider.setTopLeftPosition(0, 24);
+
+}
+
+void RotaryKnob::mouseEnter(const juce::MouseEvent &event) {
+    DBG(tooltipString);
+    if (onHover)
+        onHover(tooltipString); // Pass the tooltip to whoever is listening
+}
+
+void RotaryKnob::mouseExit(const juce::MouseEvent &event) {
+//    DBG(tooltipString);
+    if (onHover)
+        onHover("");
+}
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    SPSCQueue.h
+    Created: 18 Oct 2026 4:58:03pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include "CacheLine.h"
+
+// Wait-free ring buffer for exactly one producer thread and one consumer thread. Neither side
+// ever blocks or retries: push() fails when the queue is full, pop() when it's empty.
+//
+// The indices only ever grow (and wrap around as size_t), each side keeps a cached copy of the
+// other side's index so it only touches the shared one when it seems to have run out, and
+// everything either side writes sits on its own cache line.
+template <typename T, std::size_t Capacity>
+class SPSCQueue
+{
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "items are copied in and out, not constructed");
+
+    static constexpr std::size_t capacity = Capacity;
+
+    // Producer side. Returns false, and counts the item as dropped, when the queue is full.
+    bool push(const T& item) noexcept
+    {
+        auto write = producer.writeIndex.load(std::memory_order_relaxed);
+        if (write - producer.cachedReadIndex == Capacity) {
+            producer.cachedReadIndex = consumer.readIndex.load(std::memory_order_acquire);
+            if (write - producer.cachedReadIndex == Capacity) {
+                producer.numDropped.store(producer.numDropped.load(std::memory_order_relaxed) + 1,
+                                          std::memory_order_relaxed);
+                return false;
+            }
+        }
+        items[write & mask] = item;
+        producer.writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side. Copies the whole block, or nothing (and counts it as dropped) if it
+    // doesn't fit.
+    bool push(const T* source, std::size_t count) noexcept
+    {
+        auto write = producer.writeIndex.load(std::memory_order_relaxed);
+        if (Capacity - (write - producer.cachedReadIndex) < count) {
+            producer.cachedReadIndex = consumer.readIndex.load(std::memory_order_acquire);
+            if (Capacity - (write - producer.cachedReadIndex) < count) {
+                producer.numDropped.store(producer.numDropped.load(std::memory_order_relaxed) + count,
+                                          std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        // in at most two runs, the second one from the start of the ring
+        auto start = write & mask;
+        auto firstRun = std::min(count, Capacity - start);
+        std::copy(source, source + firstRun, items + start);
+        std::copy(source + firstRun, source + count, items);
+
+        producer.writeIndex.store(write + count, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when there is nothing to read.
+    bool pop(T& item) noexcept
+    {
+        auto read = consumer.readIndex.load(std::memory_order_relaxed);
+        if (read == consumer.cachedWriteIndex) {
+            consumer.cachedWriteIndex = producer.writeIndex.load(std::memory_order_acquire);
+            if (read == consumer.cachedWriteIndex) {
+                return false;
+            }
+        }
+        item = items[read & mask];
+        consumer.readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Copies up to maxCount items, oldest first, and returns how many.
+    std::size_t pop(T* dest, std::size_t maxCount) noexcept
+    {
+        auto read = consumer.readIndex.load(std::memory_order_relaxed);
+        if (consumer.cachedWriteIndex - read < maxCount) {
+            consumer.cachedWriteIndex = producer.writeIndex.load(std::memory_order_acquire);
+        }
+        auto numPopped = std::min(maxCount, consumer.cachedWriteIndex - read);
+
+        auto start = read & mask;
+        auto firstRun = std::min(numPopped, Capacity - start);
+        std::copy(items + start, items + start + firstRun, dest);
+        std::copy(items, items + (numPopped - firstRun), dest + firstRun);
+
+        consumer.readIndex.store(read + numPopped, std::memory_order_release);
+        return numPopped;
+    }
+
+    // Consumer side. Calls handler for everything that's in the queue right now, oldest first.
+    template <typename Handler>
+    std::size_t drain(Handler&& handler) noexcept
+    {
+        auto read = consumer.readIndex.load(std::memory_order_relaxed);
+        auto write = producer.writeIndex.load(std::memory_order_acquire);
+        consumer.cachedWriteIndex = write;
+        for (auto i = read; i != write; ++i) {
+            handler(items[i & mask]);
+        }
+        consumer.readIndex.store(write, std::memory_order_release);
+        return write - read;
+    }
+
+    // Consumer side. Throws away whatever is queued, e.g. when a reader comes back after a while,
+    // and returns how much that was.
+    std::size_t discardAll() noexcept
+    {
+        return drain([] (const T&) {});
+    }
+
+    // Consumer side. Throws away up to maxCount of the oldest items and returns how many.
+    std::size_t discard(std::size_t maxCount) noexcept
+    {
+        auto read = consumer.readIndex.load(std::memory_order_relaxed);
+        if (consumer.cachedWriteIndex - read < maxCount) {
+            consumer.cachedWriteIndex = producer.writeIndex.load(std::memory_order_acquire);
+        }
+        auto numDiscarded = std::min(maxCount, consumer.cachedWriteIndex - read);
+        consumer.readIndex.store(read + numDiscarded, std::memory_order_release);
+        return numDiscarded;
+    }
+
+    // Can be called from any thread, but is only a snapshot
+    std::size_t getNumDropped() const noexcept
+    {
+        return producer.numDropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    struct alignas(cacheLineSize) Producer
+    {
+        std::atomic<std::size_t> writeIndex { 0 };
+        std::size_t cachedReadIndex = 0;
+        std::atomic<std::size_t> numDropped { 0 };
+    };
+
+    struct alignas(cacheLineSize) Consumer
+    {
+        std::atomic<std::size_t> readIndex { 0 };
+        std::size_t cachedWriteIndex = 0;
+    };
+
+    Producer producer;
+    Consumer consumer;
+    alignas(cacheLineSize) T items[Capacity];
+};
@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    SharedResources.cpp
+    Created: 18 Oct 2026 8:41:07pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "SharedResources.h"
+
+SharedResources::SharedResources()
+{
+    // decoded here rather than through juce::ImageCache, which lets go of them again
+    // a few seconds after the last editor closes
+    logo = juce::ImageFileFormat::loadFrom(BinaryData::Logo_png, BinaryData::Logo_pngSize);
+    broc = juce::ImageFileFormat::loadFrom(BinaryData::broc_png, BinaryData::broc_pngSize);
+    
+    auto input = juce::MemoryInputStream(BinaryData::brocQuotes_txt, BinaryData::brocQuotes_txtSize, false);
+    juce::StringArray lines;
+    lines.addLines(input.readString());
+
+    for (const auto& line : lines)
+        if (line.isNotEmpty())
+            brocQuotes.push_back(line);
+}
+
+juce::String SharedResources::getRandomQuote() const
+{
+    if (brocQuotes.empty()) return "You're doing a great job!";
+
+    auto index = juce::Random::getSystemRandom().nextInt((int)brocQuotes.size());
+    return brocQuotes[size_t(index)];
+}
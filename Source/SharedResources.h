@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    SharedResources.h
+    Created: 18 Oct 2026 8:41:07pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LookAndFeel.h"
+
+// Everything an editor needs that is the same for every editor: the quotes, the decoded
+// images and the look-and-feels. Hold it with a juce::SharedResourcePointer<SharedResources>;
+// the first editor to open builds it, the others just take a reference, and it goes away
+// with the last one.
+class SharedResources
+{
+public:
+    SharedResources();
+    
+    juce::String getRandomQuote() const;
+    
+    juce::Image logo;
+    juce::Image broc;
+    
+    MainLookAndFeel mainLookAndFeel;
+    FooterLookAndFeel footerLookAndFeel;
+    
+private:
+    std::vector<juce::String> brocQuotes;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedResources)
+};
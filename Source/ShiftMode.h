@@ -1,17 +1,17 @@
-/*
-  ==============================================================================
-
-    ShiftMode.h
-    Created: 16 Jun 2025 4:35:33pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#pragma once
-
-enum class ShiftMode {
-    REPITCH,
-    FADE,
-    DUCK
-};
+/*
+  ==============================================================================
+
+    ShiftMode.h
+    Created: 16 Jun 2025 4:35:33pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+enum class ShiftMode {
+    REPITCH,
+    FADE,
+    DUCK
+};
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 18 Oct 2026 10:31:22pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+#include "Trace.h"
+
+SpectrumAnalyzer::SpectrumAnalyzer(WetSampleQueue& left_, WetSampleQueue& right_)
+    :   juce::Thread("BrocDelay spectrum"),
+        left(left_),
+        right(right_)
+{
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stop();
+}
+
+void SpectrumAnalyzer::start()
+{
+    // Whatever piled up while the analyzer was stopped is too old to show. Right first and then
+    // as much from the left, like run() pops, so the two queues stay in step (see WetSamples.h).
+    left.discard(right.discardAll());
+    numIncoming = 0;
+    startThread(juce::Thread::Priority::low);
+}
+
+void SpectrumAnalyzer::stop()
+{
+    stopThread(1000);
+}
+
+bool SpectrumAnalyzer::getSpectrum(std::array<float, numBins>& dest)
+{
+    const juce::ScopedLock sl(spectrumLock);
+    if (!hasNewSpectrum) {
+        return false;
+    }
+    dest = published;
+    hasNewSpectrum = false;
+    return true;
+}
+
+void SpectrumAnalyzer::run()
+{
+    BROCDELAY_TRACE_THREAD_NAME("Spectrum analyzer");
+    
+    while (!threadShouldExit()) {
+        // right first, see WetSamples.h
+        auto wanted = size_t(hopSize - numIncoming);
+        auto numR = right.pop(incomingR.data() + numIncoming, wanted);
+        auto numL = left.pop(incomingL.data() + numIncoming, numR);
+        jassert(numL == numR);
+        numIncoming += int(numL);
+        
+        if (numIncoming < hopSize) {
+            wait(10);
+            continue;
+        }
+        
+        analyzeFrame();
+        numIncoming = 0;
+    }
+}
+
+void SpectrumAnalyzer::analyzeFrame()
+{
+    BROCDELAY_TRACE_SCOPE("SpectrumAnalyzer::analyzeFrame");
+    
+    std::copy(history.begin() + hopSize, history.end(), history.begin());
+    for (int i = 0; i < hopSize; ++i) {
+        history[size_t(fftSize - hopSize + i)] = 0.5f * (incomingL[size_t(i)] + incomingR[size_t(i)]);
+    }
+    
+    std::fill(fftData.begin(), fftData.end(), 0.0f);
+    std::copy(history.begin(), history.end(), fftData.begin());
+    window.multiplyWithWindowingTable(fftData.data(), size_t(fftSize));
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+    
+    // a full scale sine comes out at fftSize / 2 times the window's average of 0.5
+    const float normalize = 4.0f / float(fftSize);
+    for (size_t bin = 0; bin < size_t(numBins); ++bin) {
+        float magnitude = fftData[bin] * normalize;
+        if (magnitude >= smoothed[bin]) {
+            smoothed[bin] = magnitude;
+        } else {
+            smoothed[bin] += (magnitude - smoothed[bin]) * release;
+        }
+    }
+    
+    const juce::ScopedLock sl(spectrumLock);
+    published = smoothed;
+    hasNewSpectrum = true;
+}
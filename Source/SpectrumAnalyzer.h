@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 18 Oct 2026 10:31:22pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WetSamples.h"
+
+// Runs FFTs over the wet samples on its own thread, so neither the audio thread (which only
+// copies the samples into the queues) nor the message thread does any of the work. Started
+// and stopped together with the display that owns it.
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2 + 1;
+    
+    SpectrumAnalyzer(WetSampleQueue& left, WetSampleQueue& right);
+    ~SpectrumAnalyzer() override;
+    
+    void start();
+    void stop();
+    
+    // Copies the latest smoothed magnitudes (linear, 1 = full scale sine) into dest if there
+    // are new ones since the last call. Any thread.
+    bool getSpectrum(std::array<float, numBins>& dest);
+    
+private:
+    void run() override;
+    void analyzeFrame();
+    
+    WetSampleQueue& left;
+    WetSampleQueue& right;
+    
+    // a new frame every half FFT
+    static constexpr int hopSize = fftSize / 2;
+    
+    // how much of the difference to a lower level is made up per frame
+    static constexpr float release = 0.25f;
+    
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { size_t(fftSize), juce::dsp::WindowingFunction<float>::hann, false };
+    
+    // the last fftSize samples, oldest first
+    std::array<float, fftSize> history {};
+    std::array<float, hopSize> incomingL {};
+    std::array<float, hopSize> incomingR {};
+    int numIncoming = 0;
+    
+    // the FFT works in place on twice fftSize
+    std::array<float, fftSize * 2> fftData {};
+    std::array<float, numBins> smoothed {};
+    
+    juce::CriticalSection spectrumLock;
+    std::array<float, numBins> published {};
+    bool hasNewSpectrum = false;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
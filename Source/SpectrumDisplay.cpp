@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.cpp
+    Created: 18 Oct 2026 10:48:05pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SpectrumDisplay.h"
+#include "LookAndFeel.h"
+#include "DSPKernels.h"
+#include "Trace.h"
+
+//==============================================================================
+SpectrumDisplay::SpectrumDisplay(WetSampleQueue& left, WetSampleQueue& right, const juce::AudioProcessor& processor_)
+    :   processor(processor_),
+        analyzer(left, right)
+{
+    setOpaque(true);
+    analyzer.start();
+    refreshScheduler->add(*this, *this);
+}
+
+SpectrumDisplay::~SpectrumDisplay()
+{
+    refreshScheduler->remove(*this);
+    analyzer.stop();
+}
+
+void SpectrumDisplay::paint (juce::Graphics& g)
+{
+    BROCDELAY_TRACE_SCOPE("SpectrumDisplay::paint");
+    
+    g.fillAll(Colors::SpectrumDisplay::background);
+    
+    g.setColour(Colors::SpectrumDisplay::spectrum);
+    g.fillPath(spectrumPath);
+    
+    g.setColour(Colors::SpectrumDisplay::response);
+    g.strokePath(responsePath, juce::PathStrokeType(1.5f));
+}
+
+void SpectrumDisplay::resized()
+{
+    buildSpectrumPath();
+    buildResponsePath();
+}
+
+void SpectrumDisplay::setCutoffs(float newLowCut, float newHighCut)
+{
+    lowCut = newLowCut;
+    highCut = newHighCut;
+    buildResponsePath();
+    repaint();
+}
+
+void SpectrumDisplay::refresh([[maybe_unused]] double elapsedSeconds)
+{
+    // the curve depends on the sample rate too
+    if (processor.getSampleRate() != sampleRate) {
+        sampleRate = processor.getSampleRate();
+        buildResponsePath();
+        repaint();
+    }
+    
+    if (analyzer.getSpectrum(spectrum)) {
+        buildSpectrumPath();
+        repaint();
+    }
+}
+
+float SpectrumDisplay::xForFrequency(float frequency) const noexcept
+{
+    float position = std::log(frequency / minFrequency) / std::log(maxFrequency / minFrequency);
+    return position * float(getWidth());
+}
+
+float SpectrumDisplay::yForLevel(float level) const noexcept
+{
+    float dB = juce::Decibels::gainToDecibels(level, mindB);
+    return juce::jmap(juce::jlimit(mindB, maxdB, dB), maxdB, mindB, 0.0f, float(getHeight()));
+}
+
+void SpectrumDisplay::buildSpectrumPath()
+{
+    spectrumPath.clear();
+    if (sampleRate <= 0.0 || getWidth() <= 0) {
+        return;
+    }
+    
+    // one point per pixel column, taking the loudest bin that falls into it
+    float binWidth = float(sampleRate) / float(SpectrumAnalyzer::fftSize);
+    float bottom = float(getHeight());
+    
+    spectrumPath.startNewSubPath(0.0f, bottom);
+    int bin = std::max(1, int(minFrequency / binWidth));
+    for (int x = 0; x < getWidth(); ++x) {
+        float upperFrequency = minFrequency * std::pow(maxFrequency / minFrequency, float(x + 1) / float(getWidth()));
+        float level = 0.0f;
+        while (bin < SpectrumAnalyzer::numBins && float(bin) * binWidth < upperFrequency) {
+            level = std::max(level, spectrum[size_t(bin)]);
+            ++bin;
+        }
+        spectrumPath.lineTo(float(x), yForLevel(level));
+    }
+    spectrumPath.lineTo(float(getWidth()), bottom);
+    spectrumPath.closeSubPath();
+}
+
+void SpectrumDisplay::buildResponsePath()
+{
+    responsePath.clear();
+    if (sampleRate <= 0.0 || getWidth() <= 0) {
+        return;
+    }
+    
+    // The cut filters are TPT state variable filters, whose response is the analog one at the
+    // prewarped frequency: a 2nd order high pass at lowCut followed by a low pass at highCut.
+    const double R2 = DSPKernels::cutFilterR2();
+    auto prewarp = [this] (double frequency) {
+        return std::tan(juce::MathConstants<double>::pi * std::min(frequency, 0.499 * sampleRate) / sampleRate);
+    };
+    double lowCutW = prewarp(lowCut);
+    double highCutW = prewarp(highCut);
+    
+    for (int x = 0; x <= getWidth(); ++x) {
+        double frequency = minFrequency * std::pow(maxFrequency / minFrequency, double(x) / double(getWidth()));
+        double w = prewarp(frequency);
+        
+        double h = w / lowCutW;
+        double highPass = (h * h) / std::sqrt((1.0 - h * h) * (1.0 - h * h) + (R2 * h) * (R2 * h));
+        
+        double l = w / highCutW;
+        double lowPass = 1.0 / std::sqrt((1.0 - l * l) * (1.0 - l * l) + (R2 * l) * (R2 * l));
+        
+        float y = yForLevel(float(highPass * lowPass));
+        if (x == 0) {
+            responsePath.startNewSubPath(0.0f, y);
+        } else {
+            responsePath.lineTo(float(x), y);
+        }
+    }
+}
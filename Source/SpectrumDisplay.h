@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.h
+    Created: 18 Oct 2026 10:48:05pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectrumAnalyzer.h"
+#include "RefreshScheduler.h"
+
+//==============================================================================
+/*
+    Spectrum of the repeats, with the response of the low and high cut filters on top.
+    The analyzer thread runs while the display exists.
+*/
+class SpectrumDisplay  : public juce::Component, private RefreshScheduler::Client
+{
+public:
+    SpectrumDisplay(WetSampleQueue& left, WetSampleQueue& right, const juce::AudioProcessor& processor);
+    ~SpectrumDisplay() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    // Message thread
+    void setCutoffs(float lowCut, float highCut);
+
+private:
+    void refresh(double elapsedSeconds) override;
+    
+    float xForFrequency(float frequency) const noexcept;
+    float yForLevel(float level) const noexcept;
+    void buildSpectrumPath();
+    void buildResponsePath();
+    
+    juce::SharedResourcePointer<RefreshScheduler> refreshScheduler;
+    
+    const juce::AudioProcessor& processor;
+    SpectrumAnalyzer analyzer;
+    std::array<float, SpectrumAnalyzer::numBins> spectrum {};
+    double sampleRate = 0.0;
+    
+    float lowCut = 20.0f;
+    float highCut = 20000.0f;
+    
+    // only rebuilt when new data arrives, the cutoffs change or the size changes
+    juce::Path spectrumPath;
+    juce::Path responsePath;
+    
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float mindB = -84.0f;
+    static constexpr float maxdB = 6.0f;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumDisplay)
+};
@@ -1,31 +1,33 @@
-/*
-  ==============================================================================
-
-    Tempo.h
-    Created: 3 Jun 2025 12:35:44pm
-    Author:  Brett
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-class Tempo
-{
-public:
-    void reset() noexcept;
-    
-    void update(const juce::AudioPlayHead* playhead) noexcept;
-    
-    double getMillisecondsForNoteLength(int index) const noexcept;
-    
-    double getTempo() const noexcept
-    {
-        return bpm;
-    }
-    
-private:
-    double bpm = 120.0;
-};
+/*
+  ==============================================================================
+
+    Tempo.h
+    Created: 3 Jun 2025 12:35:44pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The host's tempo, updated by the audio thread once per block. It can be read from any
+// thread, the host asks for getTailLengthSeconds() whenever it likes.
+class Tempo
+{
+public:
+    void reset() noexcept;
+    
+    void update(const juce::AudioPlayHead* playhead) noexcept;
+    
+    double getMillisecondsForNoteLength(int index) const noexcept;
+    
+    double getTempo() const noexcept
+    {
+        return bpm.load(std::memory_order_relaxed);
+    }
+    
+private:
+    std::atomic<double> bpm { 120.0 };
+};
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    Trace.cpp
+    Created: 18 Oct 2026 11:46:09pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Trace.h"
+#include "SPSCQueue.h"
+
+namespace Trace
+{
+
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        int64_t start;
+        int64_t duration;  // -1 for an instant
+    };
+
+    // Several times what a busy audio thread records between two flushes
+    using EventQueue = SPSCQueue<Event, 8192>;
+
+    struct ThreadBuffer
+    {
+        EventQueue events;
+        std::atomic<const char*> name { nullptr };
+        size_t droppedBefore = 0;  // the queue's drop count when the session started
+    };
+
+    constexpr int maxThreads = 32;
+
+    // Created by the first start() and only deleted when the process exits, so a thread that
+    // is still recording while stop() runs never writes into freed memory.
+    struct Recorder
+    {
+        ThreadBuffer threads[maxThreads];
+        std::atomic<int> numClaimed { 0 };
+
+        std::FILE* file = nullptr;
+        int64_t origin = 0;
+        bool firstEvent = true;
+
+        std::thread writer;
+        std::mutex writerMutex;
+        std::condition_variable wakeUp;
+        bool quit = false;
+    };
+
+    std::unique_ptr<Recorder> recorder;
+
+    // 0 while nothing is being recorded. Every start() begins a new session, which makes the
+    // threads claim their buffers again.
+    std::atomic<uint32_t> currentSession { 0 };
+    uint32_t lastSession = 0;
+
+    // start() and stop()
+    std::mutex controlMutex;
+
+    // Session objects
+    std::mutex sessionMutex;
+    int numSessions = 0;
+
+    struct ThreadState
+    {
+        uint32_t session = 0;
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    thread_local ThreadState threadState;
+
+    // nullptr when nothing is recorded, or when more than maxThreads threads are recording
+    ThreadBuffer* getThreadBuffer() noexcept
+    {
+        auto session = currentSession.load(std::memory_order_acquire);
+        if (session == 0) {
+            return nullptr;
+        }
+        if (threadState.session != session) {
+            threadState.session = session;
+            auto index = recorder->numClaimed.fetch_add(1, std::memory_order_relaxed);
+            threadState.buffer = index < maxThreads ? &recorder->threads[index] : nullptr;
+        }
+        return threadState.buffer;
+    }
+
+    void writeEvent(int tid, const Event& event)
+    {
+        auto& r = *recorder;
+        const char* separator = r.firstEvent ? "" : ",";
+        r.firstEvent = false;
+
+        double ts = double(event.start - r.origin) * 0.001;
+        if (event.duration < 0) {
+            std::fprintf(r.file, "%s\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                         separator, event.name, tid, ts);
+        } else {
+            std::fprintf(r.file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         separator, event.name, tid, ts, double(event.duration) * 0.001);
+        }
+    }
+
+    void flush()
+    {
+        int numThreads = std::min(recorder->numClaimed.load(std::memory_order_relaxed), maxThreads);
+        for (int i = 0; i < numThreads; ++i) {
+            recorder->threads[i].events.drain([i] (const Event& event) { writeEvent(i, event); });
+        }
+        std::fflush(recorder->file);
+    }
+
+    void writerLoop()
+    {
+        std::unique_lock<std::mutex> lock(recorder->writerMutex);
+        while (!recorder->quit) {
+            recorder->wakeUp.wait_for(lock, std::chrono::milliseconds(100));
+            flush();
+        }
+    }
+
+    void push(const Event& event) noexcept
+    {
+        if (auto* buffer = getThreadBuffer()) {
+            buffer->events.push(event);  // dropped (and counted) if the writer fell behind
+        }
+    }
+}
+
+bool start(const char* path)
+{
+    std::lock_guard<std::mutex> lock(controlMutex);
+    if (currentSession.load(std::memory_order_relaxed) != 0) {
+        return false;
+    }
+
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    if (recorder == nullptr) {
+        recorder = std::make_unique<Recorder>();
+    }
+
+    // leftovers of the previous session, from threads that were still recording when it stopped
+    for (auto& thread : recorder->threads) {
+        thread.events.discardAll();
+        thread.name.store(nullptr, std::memory_order_relaxed);
+        thread.droppedBefore = thread.events.getNumDropped();
+    }
+    recorder->numClaimed.store(0, std::memory_order_relaxed);
+
+    recorder->file = file;
+    recorder->origin = now();
+    recorder->firstEvent = true;
+    recorder->quit = false;
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    recorder->writer = std::thread(writerLoop);
+
+    // session numbers skip 0, which means "not recording"
+    if (++lastSession == 0) {
+        ++lastSession;
+    }
+    currentSession.store(lastSession, std::memory_order_release);
+    return true;
+}
+
+void stop()
+{
+    std::lock_guard<std::mutex> lock(controlMutex);
+    if (currentSession.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    currentSession.store(0, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> writerLock(recorder->writerMutex);
+        recorder->quit = true;
+    }
+    recorder->wakeUp.notify_one();
+    recorder->writer.join();
+    flush();
+
+    auto& r = *recorder;
+    size_t numDropped = 0;
+    int numThreads = std::min(r.numClaimed.load(std::memory_order_relaxed), maxThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        numDropped += r.threads[i].events.getNumDropped() - r.threads[i].droppedBefore;
+        const char* name = r.threads[i].name.load(std::memory_order_relaxed);
+        if (name != nullptr) {
+            std::fprintf(r.file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                         r.firstEvent ? "" : ",", i, name);
+            r.firstEvent = false;
+        }
+    }
+
+    std::fprintf(r.file, "\n],\"otherData\":{\"droppedEvents\":\"%zu\"}}\n", numDropped);
+    std::fclose(r.file);
+    r.file = nullptr;
+}
+
+bool isRecording() noexcept
+{
+    return currentSession.load(std::memory_order_relaxed) != 0;
+}
+
+Session::Session()
+{
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    if (numSessions++ == 0) {
+        if (const char* path = std::getenv("BROCDELAY_TRACE_FILE")) {
+            start(path);
+        }
+    }
+}
+
+Session::~Session()
+{
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    if (--numSessions == 0) {
+        stop();
+    }
+}
+
+int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void complete(const char* name, int64_t start, int64_t end) noexcept
+{
+    push({ name, start, end - start });
+}
+
+void instant(const char* name) noexcept
+{
+    push({ name, now(), -1 });
+}
+
+void nameThread(const char* name) noexcept
+{
+    if (auto* buffer = getThreadBuffer()) {
+        buffer->name.store(name, std::memory_order_relaxed);
+    }
+}
+
+}
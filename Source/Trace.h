@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    Trace.h
+    Created: 18 Oct 2026 11:46:09pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Profiling builds define this as 1. Otherwise every BROCDELAY_TRACE_* macro below is empty
+// and nothing of this file ends up in the plugin.
+#ifndef BROCDELAY_TRACE
+ #define BROCDELAY_TRACE 0
+#endif
+
+// A timeline of what the audio, message and worker threads are doing, written as Chrome trace
+// event JSON (open it in ui.perfetto.dev or chrome://tracing).
+//
+// Each thread records into its own preallocated lock-free buffer, claimed the first time it
+// records something, and a background thread moves the events to the file every 100 ms.
+// Recording never locks, waits or allocates, so it's fine on the audio thread. Only the
+// pointer to an event name is stored, so names must be string literals.
+//
+// No JUCE in here, so the headless tools can record traces too.
+namespace Trace
+{
+    // Starts writing a trace to path. Returns false if a trace is already being written or the
+    // file can't be opened. Not real-time safe, like stop().
+    bool start(const char* path);
+
+    // Writes whatever is still buffered and closes the file
+    void stop();
+
+    bool isRecording() noexcept;
+
+    // Recording sessions for the plugin: while at least one Session exists, a trace is written
+    // to the file named by the BROCDELAY_TRACE_FILE environment variable (if it's set).
+    class Session
+    {
+    public:
+        Session();
+        ~Session();
+
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+    };
+
+    // Nanoseconds on the trace's clock
+    int64_t now() noexcept;
+
+    // A span from start to end on the calling thread's track
+    void complete(const char* name, int64_t start, int64_t end) noexcept;
+
+    // A moment on the calling thread's track, e.g. a shift mode transition
+    void instant(const char* name) noexcept;
+
+    // What the calling thread's track is called. Cheap enough to call for every audio block,
+    // which keeps the name right when the host moves processing to another thread.
+    void nameThread(const char* name) noexcept;
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name_) noexcept
+            : name(name_), startTime(isRecording() ? now() : -1)
+        {
+        }
+
+        ~Scope()
+        {
+            if (startTime >= 0) {
+                complete(name, startTime, now());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        int64_t startTime;
+    };
+}
+
+#if BROCDELAY_TRACE
+ #define BROCDELAY_TRACE_JOIN2(a, b) a##b
+ #define BROCDELAY_TRACE_JOIN(a, b) BROCDELAY_TRACE_JOIN2(a, b)
+ #define BROCDELAY_TRACE_SCOPE(name) Trace::Scope BROCDELAY_TRACE_JOIN(traceScope, __LINE__) { name }
+ #define BROCDELAY_TRACE_INSTANT(name) Trace::instant(name)
+ #define BROCDELAY_TRACE_THREAD_NAME(name) Trace::nameThread(name)
+#else
+ #define BROCDELAY_TRACE_SCOPE(name)
+ #define BROCDELAY_TRACE_INSTANT(name)
+ #define BROCDELAY_TRACE_THREAD_NAME(name)
+#endif
@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    WetSamples.h
+    Created: 18 Oct 2026 10:31:22pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SPSCQueue.h"
+
+// The filtered repeats, copied block by block for the spectrum analyzer. Over 300 ms at
+// 48 kHz; when nobody reads, blocks are dropped.
+//
+// Left and right are two queues that stay in step without any extra synchronisation: the
+// audio thread pushes a block into the right queue only if it went into the left one, and
+// the reader pops from the right queue first and then takes the same number from the left.
+// That way the right queue never holds more than the left one, so the second push always
+// fits and the second pop always finds enough.
+using WetSampleQueue = SPSCQueue<float, 16384>;
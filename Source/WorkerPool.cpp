@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    WorkerPool.cpp
+    Created: 18 Oct 2026 2:21:47pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "WorkerPool.h"
+#include "Trace.h"
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+void WorkerPool::start(int numWorkers)
+{
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = false;
+    }
+
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+void WorkerPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wakeUp.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void WorkerPool::runTasks(int numTasks, TaskFunction function, void* context) noexcept
+{
+    if (workers.empty() || numTasks <= 1) {
+        for (int i = 0; i < numTasks; ++i) {
+            function(context, i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        taskFunction = function;
+        taskContext = context;
+        taskCount = numTasks;
+        nextTask.store(0, std::memory_order_relaxed);
+        ++generation;
+    }
+    wakeUp.notify_all();
+
+    runAvailableTasks(function, context, numTasks);
+
+    // every task has been claimed now, wait for the workers still running one
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return activeWorkers == 0; });
+
+    // workers that only wake up now must not join this job
+    taskCount = 0;
+}
+
+void WorkerPool::runAvailableTasks(TaskFunction function, void* context, int numTasks) noexcept
+{
+    BROCDELAY_TRACE_SCOPE("WorkerPool::runAvailableTasks");
+    
+    for (;;) {
+        int index = nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (index >= numTasks) {
+            return;
+        }
+        function(context, index);
+    }
+}
+
+void WorkerPool::workerLoop()
+{
+    BROCDELAY_TRACE_THREAD_NAME("Worker");
+    
+    unsigned int seenGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        seenGeneration = generation;
+    }
+
+    for (;;) {
+        TaskFunction function;
+        void* context;
+        int numTasks;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [&] { return quit || generation != seenGeneration; });
+            if (quit) {
+                return;
+            }
+            seenGeneration = generation;
+            if (taskCount == 0) {
+                continue;
+            }
+            function = taskFunction;
+            context = taskContext;
+            numTasks = taskCount;
+            ++activeWorkers;
+        }
+
+        runAvailableTasks(function, context, numTasks);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--activeWorkers == 0) {
+            finished.notify_all();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    WorkerPool.h
+    Created: 18 Oct 2026 2:21:47pm
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A few persistent threads that run the tasks of one job together with the calling thread.
+// Used to render the two delay channels concurrently during offline bounces. run() blocks
+// on a mutex and condition variable, so it must not be used from a real-time audio callback.
+//
+// No JUCE in here, so the headless benchmarks can measure it too.
+class WorkerPool
+{
+public:
+    WorkerPool() = default;
+    ~WorkerPool();
+
+    // Starts numWorkers threads (stopping any that were running). Call from a non-audio thread.
+    void start(int numWorkers);
+    void stop();
+
+    int getNumWorkers() const noexcept
+    {
+        return int(workers.size());
+    }
+
+    // Calls task(index) for every index in [0, numTasks) and returns when they're all done.
+    // The calling thread takes part, so with no workers the tasks simply run one after another.
+    template <typename Task>
+    void run(int numTasks, Task& task) noexcept
+    {
+        runTasks(numTasks, [] (void* context, int index) { (*static_cast<Task*>(context))(index); }, &task);
+    }
+
+private:
+    using TaskFunction = void (*)(void* context, int index);
+
+    void runTasks(int numTasks, TaskFunction function, void* context) noexcept;
+    void workerLoop();
+    void runAvailableTasks(TaskFunction function, void* context, int numTasks) noexcept;
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+
+    // the current job, guarded by mutex
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+    int taskCount = 0;
+    unsigned int generation = 0;
+    int activeWorkers = 0;
+    bool quit = false;
+
+    std::atomic<int> nextTask { 0 };
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+};
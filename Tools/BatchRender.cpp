@@ -0,0 +1,461 @@
+/*
+  ==============================================================================
+
+    BatchRender.cpp
+    Created: 19 Oct 2026 2:51:27am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Renders audio files through DelayAudioProcessor, as fast as the machine allows. Every thread
+// has a processor of its own with the same settings (from a state saved by the plugin, the
+// getStateInformation() format) and takes the next file as soon as it's done with one, the
+// longest files first so no thread is left with a big one at the end.
+//
+// Files are read, processed and written a block at a time, so memory doesn't grow with their
+// length. After the input the tail is rendered too, for as long as getEchoTailSeconds() says
+// the echoes take to die away (at most --max-tail seconds, the whole of it with feedback at
+// 100% or more). Mono files stay mono, stereo files stereo, anything else is skipped.
+//
+//   BrocDelayBatchRender [--state file] [--set id=value]... [--out dir] [--bits 16|24|32]
+//       [--block n] [--threads n] [--max-tail s] [--bpm n] files...
+//
+// WAV, AIFF, FLAC (and whatever else JUCE reads) in, WAV out with the same name: 32 bit float
+// unless --bits says otherwise. --set changes a parameter after the state is loaded, in the
+// units the plugin shows (--set feedback=60 --set delayTime=375). --threads defaults to the
+// number of cores, --block to 8192, --max-tail to 60 and --bpm (what tempo sync follows) to
+// 120. Exits with 1 when a file failed, 2 on usage errors.
+//
+// With --stream it's a filter for pipes instead: raw interleaved PCM from stdin, processed,
+// to stdout, then the tail. See PCMStream.h.
+//
+//   BrocDelayBatchRender --stream [--format f32|s16] [--rate n] [--channels 1|2] [--state file]
+//       [--set id=value]... [--block n] [--max-tail s] [--bpm n] < in.raw > out.raw
+//
+// The defaults are f32, 48000 and 2. The speed goes to stderr.
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "PluginProcessor.h"
+#include "PCMStream.h"
+#include "ScriptedPlayHead.h"
+
+namespace
+{
+    struct Settings
+    {
+        juce::MemoryBlock state;
+        juce::StringArray parameterValues;  // "id=value"
+        juce::File outputDir = juce::File::getCurrentWorkingDirectory();
+        int bitsPerSample = 32;
+        int blockSize = 8192;
+        int numThreads = juce::SystemStats::getNumCpus();
+        double maxTail = 60.0;
+        double bpm = 120.0;
+
+        bool stream = false;
+        PCMStream::Format format = PCMStream::Format::float32;
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+    };
+
+    struct Job
+    {
+        juce::File input;
+        juce::File output;
+
+        // filled in by render()
+        juce::String error;
+        double seconds = 0.0;      // of audio written, tail included
+        double tailSeconds = 0.0;
+        double renderSeconds = 0.0;
+    };
+
+    // A processor with the state and the --set values, or nullptr and what's wrong with them
+    std::unique_ptr<DelayAudioProcessor> createProcessor(const Settings& settings, juce::String& error)
+    {
+        auto processor = std::make_unique<DelayAudioProcessor>();
+        if (settings.state.getSize() > 0) {
+            processor->setStateInformation(settings.state.getData(), int(settings.state.getSize()));
+        }
+
+        for (const auto& parameterValue : settings.parameterValues) {
+            auto id = parameterValue.upToFirstOccurrenceOf("=", false, false).trim();
+            auto value = parameterValue.fromFirstOccurrenceOf("=", false, false).trim();
+            auto* parameter = processor->apvts.getParameter(id);
+            if (parameter == nullptr || value.isEmpty()) {
+                error = "can't set " + parameterValue;
+                return nullptr;
+            }
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value.getFloatValue()));
+        }
+        return processor;
+    }
+
+    // One processor per thread. A thread only ever holds one, so there's always one free.
+    class ProcessorPool
+    {
+    public:
+        explicit ProcessorPool(std::vector<std::unique_ptr<DelayAudioProcessor>> processors_) :
+            processors(std::move(processors_))
+        {
+            for (auto& processor : processors) {
+                free.push_back(processor.get());
+            }
+        }
+
+        DelayAudioProcessor& acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jassert(!free.empty());
+            auto* processor = free.back();
+            free.pop_back();
+            return *processor;
+        }
+
+        void release(DelayAudioProcessor& processor)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(&processor);
+        }
+
+    private:
+        std::vector<std::unique_ptr<DelayAudioProcessor>> processors;
+        std::vector<DelayAudioProcessor*> free;
+        std::mutex mutex;
+    };
+
+    bool setChannels(DelayAudioProcessor& processor, int numChannels)
+    {
+        auto set = numChannels == 1 ? juce::AudioChannelSet::mono() : juce::AudioChannelSet::stereo();
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(set);
+        layout.outputBuses.add(set);
+        return processor.setBusesLayout(layout);
+    }
+
+    juce::String render(DelayAudioProcessor& processor, juce::AudioFormatManager& formats, const Settings& settings,
+                        Job& job)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(job.input));
+        if (reader == nullptr) {
+            return "can't read it";
+        }
+        int numChannels = int(reader->numChannels);
+        if (numChannels < 1 || numChannels > 2) {
+            return juce::String(numChannels) + " channels, only mono and stereo work";
+        }
+        double sampleRate = reader->sampleRate;
+
+        if (!setChannels(processor, numChannels)) {
+            return "the plugin doesn't take this channel layout";
+        }
+
+        ScriptedPlayHead playHead(sampleRate);
+        playHead.setScript("0 tempo " + juce::String(settings.bpm));
+        processor.setPlayHead(&playHead);
+        // a bounce, as a host's offline render: the channels go in parallel on long blocks and
+        // the real-time checks are off
+        processor.setNonRealtime(true);
+        processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+        processor.prepareToPlay(sampleRate, settings.blockSize);
+
+        job.output.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream = job.output.createOutputStream();
+        if (stream == nullptr) {
+            return "can't write " + job.output.getFullPathName();
+        }
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(stream.get(), sampleRate, unsigned(numChannels), settings.bitsPerSample, {}, 0));
+        if (writer == nullptr) {
+            return "can't write " + job.output.getFullPathName();
+        }
+        stream.release();  // the writer owns it now
+
+        juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+
+        auto start = std::chrono::steady_clock::now();
+
+        auto inputLength = int64_t(reader->lengthInSamples);
+        int64_t length = -1;  // known once the input is through and the tempo is the one it ends at
+        bool ok = true;
+        for (int64_t position = 0; ok && (length < 0 || position < length);) {
+            if (length < 0 && position >= inputLength) {
+                double tail = std::min(processor.getEchoTailSeconds(), settings.maxTail);
+                job.tailSeconds = tail;
+                length = inputLength + int64_t(std::ceil(tail * sampleRate));
+                continue;
+            }
+
+            auto end = length < 0 ? inputLength : length;
+            int numSamples = int(std::min(int64_t(settings.blockSize), end - position));
+            int numInput = int(std::clamp(inputLength - position, int64_t(0), int64_t(numSamples)));
+
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+            block.clear();
+            if (numInput > 0) {
+                ok = reader->read(&block, 0, numInput, position, true, numChannels > 1);
+            }
+
+            processor.processBlock(block, midi);
+            ok = ok && writer->writeFromAudioSampleBuffer(block, 0, numSamples);
+
+            playHead.advance(numSamples);
+            position += numSamples;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        job.renderSeconds = elapsed.count();
+        job.seconds = double(std::max(length, int64_t(0))) / sampleRate;
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+        return ok ? juce::String() : juce::String("reading or writing failed");
+    }
+
+    // --stream: stdin to stdout until stdin ends, then the tail
+    int stream(const Settings& settings)
+    {
+        juce::String error;
+        auto processor = createProcessor(settings, error);
+        if (processor == nullptr) {
+            std::fprintf(stderr, "%s\n", error.toRawUTF8());
+            return 2;
+        }
+        if (!setChannels(*processor, settings.numChannels)) {
+            std::fprintf(stderr, "the plugin doesn't take %d channels\n", settings.numChannels);
+            return 2;
+        }
+
+        double sampleRate = settings.sampleRate;
+        ScriptedPlayHead playHead(sampleRate);
+        playHead.setScript("0 tempo " + juce::String(settings.bpm));
+        processor->setPlayHead(&playHead);
+        processor->setNonRealtime(true);  // as fast as the pipe goes, like render()
+        processor->setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+        processor->prepareToPlay(sampleRate, settings.blockSize);
+
+        PCMStream::setBinaryMode(stdin);
+        PCMStream::setBinaryMode(stdout);
+        PCMStream::Reader reader(stdin, settings.format, settings.numChannels, settings.blockSize);
+        PCMStream::Writer writer(stdout, settings.format, settings.numChannels, settings.blockSize);
+
+        juce::AudioBuffer<float> buffer(settings.numChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+
+        auto process = [&] (int numSamples) {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), settings.numChannels, numSamples);
+            processor->processBlock(block, midi);
+            playHead.advance(numSamples);
+            return writer.write(block.getArrayOfReadPointers(), numSamples);
+        };
+
+        auto start = std::chrono::steady_clock::now();
+
+        bool ok = true;
+        while (ok) {
+            int numSamples = reader.read(buffer.getArrayOfWritePointers());
+            if (numSamples == 0) {
+                break;
+            }
+            ok = process(numSamples);
+        }
+        if (reader.hasError()) {
+            std::fprintf(stderr, "reading stdin failed\n");
+            ok = false;
+        }
+
+        double tail = std::min(processor->getEchoTailSeconds(), settings.maxTail);
+        auto tailLength = ok ? int64_t(std::ceil(tail * sampleRate)) : 0;
+        for (int64_t position = 0; ok && position < tailLength;) {
+            int numSamples = int(std::min(int64_t(settings.blockSize), tailLength - position));
+            buffer.clear();
+            ok = process(numSamples);
+            position += numSamples;
+        }
+        ok = ok && std::fflush(stdout) == 0;
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double seconds = double(playHead.getTimeInSamples()) / sampleRate;
+        std::fprintf(stderr, "%.1f s (%.1f s tail) in %.2f s, %.0fx real time\n", seconds,
+                     double(tailLength) / sampleRate, elapsed.count(),
+                     elapsed.count() > 0.0 ? seconds / elapsed.count() : 0.0);
+
+        processor->releaseResources();
+        processor->setPlayHead(nullptr);
+        return ok ? 0 : 1;
+    }
+
+    juce::File getFile(const juce::String& path)
+    {
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    }
+
+    bool parseOptions(int argc, char* argv[], Settings& settings, std::vector<Job>& jobs)
+    {
+        juce::StringArray inputs;
+        for (int i = 1; i < argc; ++i) {
+            juce::String arg(argv[i]);
+            if (!arg.startsWith("--")) {
+                inputs.add(arg);
+                continue;
+            }
+            if (arg == "--stream") {
+                settings.stream = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            juce::String value(argv[++i]);
+
+            if (arg == "--state") {
+                if (!getFile(value).loadFileAsData(settings.state)) {
+                    std::fprintf(stderr, "can't read %s\n", value.toRawUTF8());
+                    return false;
+                }
+            }
+            else if (arg == "--format") {
+                if (!PCMStream::parseFormat(value.toRawUTF8(), settings.format)) {
+                    return false;
+                }
+            }
+            else if (arg == "--set")      settings.parameterValues.add(value);
+            else if (arg == "--out")      settings.outputDir = getFile(value);
+            else if (arg == "--bits")     settings.bitsPerSample = value.getIntValue();
+            else if (arg == "--block")    settings.blockSize = value.getIntValue();
+            else if (arg == "--threads")  settings.numThreads = value.getIntValue();
+            else if (arg == "--max-tail") settings.maxTail = value.getDoubleValue();
+            else if (arg == "--bpm")      settings.bpm = value.getDoubleValue();
+            else if (arg == "--rate")     settings.sampleRate = value.getDoubleValue();
+            else if (arg == "--channels") settings.numChannels = value.getIntValue();
+            else return false;
+        }
+
+        if (settings.stream) {
+            return inputs.isEmpty() && settings.sampleRate > 0.0
+                && (settings.numChannels == 1 || settings.numChannels == 2)
+                && settings.blockSize >= 1 && settings.maxTail >= 0.0 && settings.bpm > 0.0;
+        }
+        if (inputs.isEmpty() || settings.blockSize < 1 || settings.numThreads < 1 || settings.maxTail < 0.0
+                || settings.bpm <= 0.0 || (settings.bitsPerSample != 16 && settings.bitsPerSample != 24
+                                           && settings.bitsPerSample != 32)) {
+            return false;
+        }
+
+        for (const auto& input : inputs) {
+            Job job;
+            job.input = getFile(input);
+            job.output = settings.outputDir.getChildFile(job.input.getFileNameWithoutExtension() + ".wav");
+            for (const auto& other : jobs) {
+                if (other.output == job.output) {
+                    std::fprintf(stderr, "%s and %s would both go to %s\n", other.input.getFullPathName().toRawUTF8(),
+                                 job.input.getFullPathName().toRawUTF8(), job.output.getFullPathName().toRawUTF8());
+                    return false;
+                }
+            }
+            if (job.output == job.input) {
+                std::fprintf(stderr, "%s would be overwritten, use --out\n", job.input.getFullPathName().toRawUTF8());
+                return false;
+            }
+            jobs.push_back(job);
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    std::vector<Job> jobs;
+    if (!parseOptions(argc, argv, settings, jobs)) {
+        std::fprintf(stderr, "usage: %s [--state file] [--set id=value]... [--out dir] [--bits 16|24|32]\n"
+                             "    [--block n] [--threads n] [--max-tail s] [--bpm n] files...\n"
+                             "   or %s --stream [--format f32|s16] [--rate n] [--channels 1|2] [--state file]\n"
+                             "    [--set id=value]... [--block n] [--max-tail s] [--bpm n]\n", argv[0], argv[0]);
+        return 2;
+    }
+    if (settings.stream) {
+        juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        return stream(settings);
+    }
+    if (!settings.outputDir.createDirectory()) {
+        std::fprintf(stderr, "can't create %s\n", settings.outputDir.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    // the biggest files first, the size standing in for the length
+    std::stable_sort(jobs.begin(), jobs.end(), [] (const Job& a, const Job& b) {
+        return a.input.getSize() > b.input.getSize();
+    });
+
+    int numThreads = std::min(settings.numThreads, int(jobs.size()));
+    std::vector<std::unique_ptr<DelayAudioProcessor>> created;
+    for (int i = 0; i < numThreads; ++i) {
+        juce::String error;
+        created.push_back(createProcessor(settings, error));
+        if (created.back() == nullptr) {
+            std::fprintf(stderr, "%s\n", error.toRawUTF8());
+            return 2;
+        }
+    }
+    ProcessorPool processors(std::move(created));
+    std::mutex printMutex;
+
+    auto task = [&] (int index) {
+        auto& job = jobs[size_t(index)];
+        auto& processor = processors.acquire();
+        job.error = render(processor, formats, settings, job);
+        processors.release(processor);
+
+        std::lock_guard<std::mutex> lock(printMutex);
+        if (job.error.isNotEmpty()) {
+            std::fprintf(stderr, "%s: %s\n", job.input.getFullPathName().toRawUTF8(), job.error.toRawUTF8());
+        } else {
+            std::printf("%s: %.1f s (%.1f s tail) in %.2f s, %.0fx real time\n", job.output.getFileName().toRawUTF8(),
+                        job.seconds, job.tailSeconds, job.renderSeconds,
+                        job.renderSeconds > 0.0 ? job.seconds / job.renderSeconds : 0.0);
+        }
+        std::fflush(stdout);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    // the calling thread renders too
+    WorkerPool pool;
+    pool.start(numThreads - 1);
+    pool.run(int(jobs.size()), task);
+    pool.stop();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double totalSeconds = 0.0;
+    int numFailed = 0;
+    for (const auto& job : jobs) {
+        totalSeconds += job.seconds;
+        numFailed += job.error.isNotEmpty() ? 1 : 0;
+    }
+
+    std::printf("\n%d files, %.1f s of audio in %.2f s on %d threads: %.0fx real time, %.0fx per thread\n",
+                int(jobs.size()) - numFailed, totalSeconds, elapsed.count(), numThreads,
+                totalSeconds / elapsed.count(), totalSeconds / elapsed.count() / numThreads);
+    if (numFailed > 0) {
+        std::printf("%d failed\n", numFailed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+    EngineCheck.cpp
+    Created: 19 Oct 2026 6:12:35am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Checks behaviour of DelayEngine that the golden output files can't show on their own, without
+// JUCE or a plugin host. Prints a line per check and exits with 1 when any of them failed.
+//
+//   BrocDelayEngineCheck
+//
+// Built with BROCDELAY_REALTIME_CHECK, every render runs on a RealtimeCheck::Scope as if it
+// were the audio thread, and one more with all parameters automated at once. Any allocation or
+// lock in there is printed to stderr and fails the run.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+#include "../Source/DelayEngine.h"
+#include "../Source/RealtimeCheck.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int hostBlockSize = 1024;  // what the "host" hands over at a time
+    constexpr int engineBlockSize = 256; // smaller, so a host block is processed in chunks
+
+    int numFailed = 0;
+
+    void check(bool passed, const char* name, const char* detail)
+    {
+        std::printf("%-34s%s  %s\n", name, passed ? "ok    " : "FAILED", detail);
+        numFailed += passed ? 0 : 1;
+    }
+
+    std::vector<float> makeNoise(int numSamples)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-0.25f, 0.25f);
+        std::vector<float> noise(size_t(numSamples), 0.0f);
+        for (auto& x : noise) x = dist(rng);
+        return noise;
+    }
+
+    // Before every host block: the transport position to report (or -1 for none) and any
+    // parameter changes
+    using Automation = std::function<int64_t(DelayEngine& engine, int64_t sample)>;
+
+    std::vector<float> render(const std::vector<float>& input, const Automation& automate)
+    {
+        DelayEngine engine;
+        engine.setParameter(DelayEngine::mix, 100.0f);
+        engine.setParameter(DelayEngine::delayTime, 250.0f);
+        engine.prepare(sampleRate, engineBlockSize);
+
+        int numSamples = int(input.size());
+        std::vector<float> output(input.size());
+        for (int offset = 0; offset < numSamples; offset += hostBlockSize) {
+            BROCDELAY_REALTIME_SCOPE(true);
+            int64_t position = automate(engine, offset);
+            engine.setHasPosition(position >= 0);
+            if (position >= 0) {
+                engine.setTimeInSamples(position);
+            }
+            int blockSize = std::min(hostBlockSize, numSamples - offset);
+            engine.process(input.data() + offset, input.data() + offset, output.data() + offset,
+                           output.data() + offset, blockSize);
+        }
+        return output;
+    }
+
+    double getRMS(const std::vector<float>& audio, double startSeconds, double endSeconds)
+    {
+        int start = int(startSeconds * sampleRate);
+        int end = std::min(int(endSeconds * sampleRate), int(audio.size()));
+        double sum = 0.0;
+        for (int i = start; i < end; ++i) {
+            sum += double(audio[size_t(i)]) * double(audio[size_t(i)]);
+        }
+        return std::sqrt(sum / std::max(1, end - start));
+    }
+
+    // The delay time changes from 250 to 400 ms at 0.5 s and to 300 ms at 1.5 s. With loop, the
+    // transport jumps from 0.5 s back to 0 right when the first change happens.
+    Automation delayChanges(bool position, bool loop)
+    {
+        return [position, loop] (DelayEngine& engine, int64_t sample) -> int64_t {
+            int64_t change = int64_t(0.5 * sampleRate) / hostBlockSize * hostBlockSize;
+            int64_t secondChange = int64_t(1.5 * sampleRate) / hostBlockSize * hostBlockSize;
+            if (sample == change) {
+                engine.setParameter(DelayEngine::delayTime, 400.0f);
+            } else if (sample == secondChange) {
+                engine.setParameter(DelayEngine::delayTime, 300.0f);
+            }
+            if (!position) {
+                return -1;
+            }
+            return loop && sample >= change ? sample - change : sample;
+        };
+    }
+
+    void checkLoopDuck()
+    {
+        auto input = makeNoise(int(2.0 * sampleRate));
+
+        auto withoutPosition = render(input, delayChanges(false, false));
+        auto straight = render(input, delayChanges(true, false));
+        auto looped = render(input, delayChanges(true, true));
+
+        // the host blocks are split into several engine blocks with the same position
+        bool same = std::memcmp(withoutPosition.data(), straight.data(), straight.size() * sizeof(float)) == 0;
+        check(same, "position moving forward", "renders like no position at all");
+
+        char detail[128];
+        double change = double(int64_t(0.5 * sampleRate) / hostBlockSize * hostBlockSize) / sampleRate;
+        double ratio = getRMS(looped, change + 0.03, change + 0.06) / getRMS(straight, change + 0.03, change + 0.06);
+        std::snprintf(detail, sizeof(detail), "echoes at %.2f of the level without the loop", ratio);
+        check(ratio < 0.6, "loop with a delay change", detail);
+
+        // long after the loop, delay changes repitch again like without it
+        double secondChange = double(int64_t(1.5 * sampleRate) / hostBlockSize * hostBlockSize) / sampleRate;
+        ratio = getRMS(looped, secondChange + 0.03, secondChange + 0.06)
+              / getRMS(straight, secondChange + 0.03, secondChange + 0.06);
+        std::snprintf(detail, sizeof(detail), "echoes at %.2f of the level without the loop", ratio);
+        check(ratio > 0.9, "delay change after the loop", detail);
+    }
+
+   #if BROCDELAY_REALTIME_CHECK
+    // Every few blocks each parameter jumps somewhere else in its range and the tempo changes,
+    // while the transport loops every second
+    void checkRealtime()
+    {
+        auto input = makeNoise(int(4.0 * sampleRate));
+
+        std::mt19937 rng(5678);
+        render(input, [&rng] (DelayEngine& engine, int64_t sample) -> int64_t {
+            if (sample % (4 * hostBlockSize) == 0) {
+                std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+                for (int p = 0; p < DelayEngine::numParameters; ++p) {
+                    const auto& info = DelayEngine::getParameterInfo(p);
+                    engine.setParameter(p, info.minimum + dist(rng) * (info.maximum - info.minimum));
+                }
+                engine.setTempo(60.0 + 120.0 * double(dist(rng)));
+            }
+            return sample % int64_t(sampleRate);
+        });
+
+        char detail[128];
+        int numViolations = RealtimeCheck::report(stderr, "DelayEngine::process");
+        std::snprintf(detail, sizeof(detail), "%d allocations or locks on the audio thread", numViolations);
+        check(numViolations == 0, "real-time safe", detail);
+    }
+   #endif
+}
+
+int main()
+{
+    checkLoopDuck();
+   #if BROCDELAY_REALTIME_CHECK
+    checkRealtime();
+   #endif
+
+    if (numFailed > 0) {
+        std::printf("\n%d check%s failed\n", numFailed, numFailed == 1 ? "" : "s");
+        return 1;
+    }
+    return 0;
+}
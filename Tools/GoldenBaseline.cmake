@@ -0,0 +1,61 @@
+# Builds BrocDelayGoldenOutput for a commit from before the tool existed, such as the original
+# Projucer-only plugin. RecordGolden.cmake copies this file in as the exported commit's
+# CMakeLists.txt, together with today's GoldenOutput.cpp, ScriptedPlayHead and RealtimeCheck,
+# and configures it with -DBROCDELAY_JUCE_DIR. The tool only needs DelayAudioProcessor, its apvts
+# and ParamIDs, which the plugin has had from the start.
+#
+# Everything in the commit's Source is compiled in, since there's no list of its files other
+# than the .jucer.
+
+cmake_minimum_required(VERSION 3.22)
+
+project(BrocDelayGoldenBaseline LANGUAGES C CXX)
+
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+    set(CMAKE_BUILD_TYPE Release)
+endif()
+
+if(NOT EXISTS "${BROCDELAY_JUCE_DIR}/CMakeLists.txt")
+    message(FATAL_ERROR "No JUCE checkout at ${BROCDELAY_JUCE_DIR}")
+endif()
+add_subdirectory("${BROCDELAY_JUCE_DIR}" JUCE EXCLUDE_FROM_ALL)
+
+# the logo and a single quote stand in for broc.png and brocQuotes.txt, like in the main build
+set(assets "${CMAKE_CURRENT_BINARY_DIR}/Assets")
+configure_file(Source/Assets/Images/Logo.png "${assets}/broc.png" COPYONLY)
+file(WRITE "${assets}/brocQuotes.txt" "You're doing a great job!\n")
+
+juce_add_binary_data(BrocDelayBinaryData
+    HEADER_NAME BinaryData.h
+    NAMESPACE BinaryData
+    SOURCES
+        Source/Assets/Fonts/Lato-Medium.ttf
+        Source/Assets/Images/Logo.png
+        "${assets}/broc.png"
+        "${assets}/brocQuotes.txt")
+
+file(GLOB plugin_sources CONFIGURE_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/Source/*.cpp")
+
+juce_add_console_app(BrocDelayGoldenOutput)
+juce_generate_juce_header(BrocDelayGoldenOutput)
+target_sources(BrocDelayGoldenOutput PRIVATE
+    Tools/GoldenOutput.cpp
+    Tools/ScriptedPlayHead.cpp
+    ${plugin_sources})
+target_include_directories(BrocDelayGoldenOutput PRIVATE Source Tools)
+target_compile_definitions(BrocDelayGoldenOutput PRIVATE
+    JucePlugin_Name="BrocDelay"
+    JucePlugin_WantsMidiInput=0
+    JucePlugin_ProducesMidiOutput=0
+    JucePlugin_IsMidiEffect=0
+    JUCE_WEB_BROWSER=0
+    JUCE_USE_CURL=0)
+target_link_libraries(BrocDelayGoldenOutput PRIVATE
+    BrocDelayBinaryData
+    juce::juce_audio_utils
+    juce::juce_dsp
+    juce::juce_recommended_config_flags
+    juce::juce_recommended_lto_flags)
@@ -0,0 +1,492 @@
+/*
+  ==============================================================================
+
+    GoldenOutput.cpp
+    Created: 19 Oct 2026 12:47:10am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+// Renders a fixed set of scenarios through DelayAudioProcessor and either stores the results
+// as reference files or compares a new build against them. Vectorising or reordering the DSP
+// changes the float results a little; this says whether it changed the sound.
+//
+//   BrocDelayGoldenOutput record <dir>
+//   BrocDelayGoldenOutput compare <dir> [--ulps n] [--floor dB] [--report dir] [--only name]
+//
+// Each scenario is two seconds of stereo at 48 kHz, written as a 32 bit float WAV. A sample
+// passes when it's within --ulps units in the last place of the reference (default 256) or
+// the difference is below --floor dBFS (default -120), which keeps near-silent samples, where
+// a single ULP is tiny, from failing on noise. For every scenario that fails, the output and
+// the difference (output - reference) are written to the report directory (default: the
+// current one) next to report.txt. Exits with 1 when anything failed, 2 on usage errors or
+// missing references.
+//
+// The BrocDelayGoldenRecord target records the references with a build of a given commit (the
+// BROCDELAY_GOLDEN_REF cache variable), BrocDelayGoldenCompare compares the current build.
+//
+// Built with BROCDELAY_REALTIME_CHECK, every scenario also has to get through processBlock
+// without allocating or locking; violations are printed per scenario and fail the run too.
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+#include "PluginProcessor.h"
+#include "RealtimeCheck.h"
+#include "ScriptedPlayHead.h"
+
+// RecordGolden.cmake also builds this against commits from before the DSPKernels
+#if __has_include("DSPKernels.h")
+ #include "DSPKernels.h"
+ #define BROCDELAY_GOLDEN_HAS_KERNELS 1
+#else
+ #define BROCDELAY_GOLDEN_HAS_KERNELS 0
+#endif
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 256;
+    constexpr int numChannels = 2;
+    constexpr double lengthSeconds = 2.0;
+
+    int numRealtimeViolations = 0;
+
+    struct Render
+    {
+        DelayAudioProcessor& processor;
+
+        void set(const juce::ParameterID& id, float value)
+        {
+            auto* param = processor.apvts.getParameter(id.getParamID());
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+        }
+    };
+
+    enum class Input { impulse, sweep, noise };
+
+    struct Scenario
+    {
+        const char* name;
+        Input input;
+        std::function<void(Render&)> setup;
+        std::function<void(Render&, double time)> automate;  // before every block, may be empty
+        std::vector<int> blockSizes {};  // cycled through instead of blockSize when not empty
+        const char* transport = "";      // a ScriptedPlayHead script, playing at 120 bpm without one
+    };
+
+    void fillInput(juce::AudioBuffer<float>& input, Input kind)
+    {
+        input.clear();
+        int numSamples = input.getNumSamples();
+        if (kind == Input::impulse) {
+            // a few impulses, so the repeats of one don't hide the start of the next
+            for (int i = 0; i < numSamples; i += int(sampleRate * 0.6)) {
+                input.setSample(0, i, 1.0f);
+                input.setSample(1, i, 0.5f);
+            }
+        } else if (kind == Input::sweep) {
+            // logarithmic 20 Hz to 20 kHz over the first second, right channel a quarter later
+            double duration = 1.0;
+            double k = std::log(20000.0 / 20.0);
+            for (int channel = 0; channel < numChannels; ++channel) {
+                int offset = channel * int(sampleRate * 0.25);
+                for (int i = 0; i < int(duration * sampleRate) && i + offset < numSamples; ++i) {
+                    double t = double(i) / sampleRate;
+                    double phase = 2.0 * juce::MathConstants<double>::pi * 20.0 * duration / k
+                                 * (std::exp(t * k / duration) - 1.0);
+                    input.setSample(channel, i + offset, float(0.5 * std::sin(phase)));
+                }
+            }
+        } else {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> dist(-0.25f, 0.25f);
+            for (int channel = 0; channel < numChannels; ++channel) {
+                for (int i = 0; i < numSamples; ++i) {
+                    input.setSample(channel, i, dist(rng));
+                }
+            }
+        }
+    }
+
+    // Delay time jumps that make the shift mode do something
+    void jumpDelayTime(Render& render, double time)
+    {
+        render.set(ParamIDs::delayTime, time < 0.5 ? 250.0f : time < 1.2 ? 400.0f : 150.0f);
+    }
+
+    // Changes the delay time in the first block after each of the loops (the transport jumps
+    // back in the playhead's advance() after the block they fall into). Without a change there,
+    // the DUCK that loops switch to would have nothing to duck.
+    std::function<void(Render&, double)> loopDelayTime(std::vector<double> loopTimes)
+    {
+        return [loopTimes] (Render& render, double time) {
+            auto numLoops = std::count_if(loopTimes.begin(), loopTimes.end(), [time] (double t) { return time >= t; });
+            render.set(ParamIDs::delayTime, numLoops % 2 == 0 ? 250.0f : 400.0f);
+        };
+    }
+
+    std::vector<Scenario> getScenarios()
+    {
+        auto shiftMode = [] (int mode) {
+            return [mode] (Render& render) {
+                render.set(ParamIDs::accelerateMode, float(mode));
+                render.set(ParamIDs::decelerateMode, float(mode));
+                render.set(ParamIDs::feedback, 50.0f);
+            };
+        };
+        auto tempoSync = [] (Render& render) {
+            render.set(ParamIDs::tempoSync, 1.0f);
+            render.set(ParamIDs::delayNote, 6.0f);  // 1/8
+            render.set(ParamIDs::feedback, 50.0f);
+        };
+
+        return {
+            { "impulse", Input::impulse, [] (Render& render) {
+                render.set(ParamIDs::feedback, 50.0f);
+            }, {} },
+            { "sweep", Input::sweep, [] (Render& render) {
+                render.set(ParamIDs::feedback, 40.0f);
+                render.set(ParamIDs::lowCut, 200.0f);
+                render.set(ParamIDs::highCut, 6000.0f);
+            }, {} },
+            { "noise", Input::noise, [] (Render& render) {
+                render.set(ParamIDs::feedback, 60.0f);
+                render.set(ParamIDs::mix, 70.0f);
+            }, {} },
+            { "repitch", Input::noise, shiftMode(0), jumpDelayTime },
+            { "fade", Input::noise, shiftMode(1), jumpDelayTime },
+            { "duck", Input::noise, shiftMode(2), jumpDelayTime },
+            { "tempo-change", Input::impulse, tempoSync, {}, {}, "1 tempo 90" },
+            { "tempo-ramp", Input::impulse, tempoSync, {}, {}, "0.25 ramp 80 1.5" },
+            { "no-tempo", Input::impulse, tempoSync, {}, {}, "0.5 notempo; 1 noposition; 1.5 position" },
+            { "loop-jump", Input::noise, [] (Render& render) {
+                render.set(ParamIDs::feedback, 50.0f);
+            }, loopDelayTime({ 1.0 }), {}, "1 seek 0.25" },
+            { "loop-region", Input::noise, [] (Render& render) {
+                render.set(ParamIDs::feedback, 50.0f);
+            }, loopDelayTime({ 0.75, 1.25, 1.75 }), {}, "0 loop 0.25 0.75" },
+            { "stop-start", Input::noise, [] (Render& render) {
+                render.set(ParamIDs::feedback, 50.0f);
+            }, jumpDelayTime, {}, "0.7 stop; 1.1 play; 1.5 seek 0.1" },
+            { "feedback+105", Input::impulse, [] (Render& render) {
+                render.set(ParamIDs::feedback, 105.0f);
+            }, {} },
+            { "feedback-105", Input::impulse, [] (Render& render) {
+                render.set(ParamIDs::feedback, -105.0f);
+            }, {} },
+            { "flipflop-off", Input::impulse, [] (Render& render) {
+                render.set(ParamIDs::feedback, 70.0f);
+            }, {} },
+            { "flipflop-on", Input::impulse, [] (Render& render) {
+                render.set(ParamIDs::feedback, 70.0f);
+                render.set(ParamIDs::flipFlop, 1.0f);
+            }, {} },
+            { "odd-blocks", Input::sweep, [] (Render& render) {
+                render.set(ParamIDs::feedback, 50.0f);
+            }, jumpDelayTime, { 1, 37, 256, 511, 3, 1024, 160 } }
+        };
+    }
+
+    juce::AudioBuffer<float> render(const Scenario& scenario)
+    {
+        DelayAudioProcessor processor;
+        ScriptedPlayHead playHead(sampleRate);
+        [[maybe_unused]] auto scriptResult = playHead.setScript(scenario.transport);
+        jassert(scriptResult.wasOk());
+        processor.setPlayHead(&playHead);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+
+        Render context { processor };
+        scenario.setup(context);
+
+        int maxBlockSize = blockSize;
+        for (auto size : scenario.blockSizes) {
+            maxBlockSize = std::max(maxBlockSize, size);
+        }
+        processor.prepareToPlay(sampleRate, maxBlockSize);
+
+        int numSamples = int(lengthSeconds * sampleRate);
+        juce::AudioBuffer<float> audio(numChannels, numSamples);
+        fillInput(audio, scenario.input);
+
+        juce::MidiBuffer midi;
+        size_t blockIndex = 0;
+        for (int position = 0; position < numSamples;) {
+            int size = scenario.blockSizes.empty() ? blockSize : scenario.blockSizes[blockIndex++ % scenario.blockSizes.size()];
+            size = std::min(size, numSamples - position);
+
+            if (scenario.automate) {
+                scenario.automate(context, double(position) / sampleRate);
+            }
+
+            // processed in place, like a host does
+            juce::AudioBuffer<float> block(audio.getArrayOfWritePointers(), numChannels, position, size);
+            processor.processBlock(block, midi);
+
+            playHead.advance(size);
+            position += size;
+        }
+
+        processor.releaseResources();
+
+       #if BROCDELAY_REALTIME_CHECK
+        numRealtimeViolations += RealtimeCheck::report(stderr, scenario.name);
+       #endif
+        return audio;
+    }
+
+    bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        file.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+        if (stream == nullptr) {
+            return false;
+        }
+
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            format.createWriterFor(stream.get(), sampleRate, unsigned(audio.getNumChannels()), 32, {}, 0));
+        if (writer == nullptr) {
+            return false;
+        }
+        stream.release();  // the writer owns it now
+        return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+    }
+
+    bool readWav(const juce::File& file, juce::AudioBuffer<float>& audio)
+    {
+        if (!file.existsAsFile()) {
+            return false;
+        }
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(file.createInputStream().release(), true));
+        if (reader == nullptr || !reader->usesFloatingPointData || reader->bitsPerSample != 32) {
+            return false;
+        }
+        audio.setSize(int(reader->numChannels), int(reader->lengthInSamples));
+        return reader->read(&audio, 0, int(reader->lengthInSamples), 0, true, true);
+    }
+
+    // How many floats lie between a and b
+    int64_t ulpDistance(float a, float b)
+    {
+        auto ordered = [] (float x) {
+            int32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            // negative floats count down from zero
+            return bits < 0 ? int64_t(std::numeric_limits<int32_t>::min()) - int64_t(bits) : int64_t(bits);
+        };
+        return std::abs(ordered(a) - ordered(b));
+    }
+
+    float toDecibels(double gain)
+    {
+        return gain > 0.0 ? float(20.0 * std::log10(gain)) : -std::numeric_limits<float>::infinity();
+    }
+
+    struct Comparison
+    {
+        bool passed = true;
+        int64_t maxUlps = 0;
+        double maxDifference = 0.0;
+        int64_t numFailed = 0;
+        int firstFailedChannel = -1;
+        int firstFailedSample = -1;
+    };
+
+    Comparison compare(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference,
+                       int64_t allowedUlps, double floor)
+    {
+        Comparison result;
+        if (output.getNumChannels() != reference.getNumChannels()
+                || output.getNumSamples() != reference.getNumSamples()) {
+            result.passed = false;
+            return result;
+        }
+
+        for (int channel = 0; channel < output.getNumChannels(); ++channel) {
+            const float* out = output.getReadPointer(channel);
+            const float* ref = reference.getReadPointer(channel);
+            for (int i = 0; i < output.getNumSamples(); ++i) {
+                bool bothNaN = std::isnan(out[i]) && std::isnan(ref[i]);
+                auto ulps = bothNaN ? 0 : ulpDistance(out[i], ref[i]);
+                double difference = std::abs(double(out[i]) - double(ref[i]));
+                if (std::isnan(difference) && !bothNaN) {
+                    difference = std::numeric_limits<double>::infinity();
+                }
+
+                result.maxUlps = std::max(result.maxUlps, ulps);
+                result.maxDifference = std::max(result.maxDifference, difference);
+
+                if (ulps > allowedUlps && difference > floor) {
+                    if (result.numFailed++ == 0) {
+                        result.firstFailedChannel = channel;
+                        result.firstFailedSample = i;
+                    }
+                    result.passed = false;
+                }
+            }
+        }
+        return result;
+    }
+
+    juce::File getFile(const juce::String& path)
+    {
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    }
+
+    int record(const juce::File& dir)
+    {
+        if (!dir.createDirectory()) {
+            std::fprintf(stderr, "can't create %s\n", dir.getFullPathName().toRawUTF8());
+            return 2;
+        }
+        for (const auto& scenario : getScenarios()) {
+            auto file = dir.getChildFile(juce::String(scenario.name) + ".wav");
+            if (!writeWav(file, render(scenario))) {
+                std::fprintf(stderr, "can't write %s\n", file.getFullPathName().toRawUTF8());
+                return 2;
+            }
+            std::printf("recorded %s\n", scenario.name);
+        }
+        return 0;
+    }
+
+    const char* getKernelsName()
+    {
+       #if BROCDELAY_GOLDEN_HAS_KERNELS
+        return DSPKernels::get().name;
+       #else
+        return "none";
+       #endif
+    }
+
+    int compareAll(const juce::File& dir, const juce::File& reportDir, int64_t allowedUlps, float floorDb,
+                   const juce::String& only)
+    {
+        double floor = std::pow(10.0, floorDb / 20.0);
+        juce::String report;
+        report << "max " << juce::String(allowedUlps) << " ulps, floor " << juce::String(floorDb, 1) << " dBFS, kernels "
+               << getKernelsName() << "\n\n";
+
+        int numFailed = 0;
+        int numCompared = 0;
+        for (const auto& scenario : getScenarios()) {
+            if (only.isNotEmpty() && only != scenario.name) {
+                continue;
+            }
+            ++numCompared;
+
+            juce::AudioBuffer<float> reference;
+            auto referenceFile = dir.getChildFile(juce::String(scenario.name) + ".wav");
+            if (!readWav(referenceFile, reference)) {
+                std::fprintf(stderr, "no reference %s, run record first\n", referenceFile.getFullPathName().toRawUTF8());
+                return 2;
+            }
+
+            auto output = render(scenario);
+            auto result = compare(output, reference, allowedUlps, floor);
+
+            auto line = juce::String(scenario.name).paddedRight(' ', 16)
+                      + (result.passed ? "pass" : "FAIL")
+                      + "  max " + juce::String(result.maxUlps) + " ulps"
+                      + ", max difference " + juce::String(toDecibels(result.maxDifference), 1) + " dBFS";
+            if (!result.passed) {
+                ++numFailed;
+                if (result.firstFailedSample >= 0) {
+                    line << ", " << juce::String(result.numFailed) << " samples over, first at channel "
+                         << juce::String(result.firstFailedChannel) << " sample " << juce::String(result.firstFailedSample)
+                         << " (" << juce::String(result.firstFailedSample / sampleRate, 4) << " s)";
+                } else {
+                    line << ", length or channel count differs";
+                }
+
+                reportDir.createDirectory();
+                writeWav(reportDir.getChildFile(juce::String(scenario.name) + ".output.wav"), output);
+                if (result.firstFailedSample >= 0) {
+                    juce::AudioBuffer<float> difference;
+                    difference.makeCopyOf(output);
+                    for (int channel = 0; channel < numChannels; ++channel) {
+                        difference.addFrom(channel, 0, reference, channel, 0, reference.getNumSamples(), -1.0f);
+                    }
+                    writeWav(reportDir.getChildFile(juce::String(scenario.name) + ".diff.wav"), difference);
+                }
+            }
+            std::printf("%s\n", line.toRawUTF8());
+            report << line << "\n";
+        }
+
+        if (numCompared == 0) {
+            std::fprintf(stderr, "no scenario called %s\n", only.toRawUTF8());
+            return 2;
+        }
+
+        if (numFailed > 0) {
+            reportDir.createDirectory();
+            reportDir.getChildFile("report.txt").replaceWithText(report);
+            std::printf("\n%d of %d failed, see %s\n", numFailed, numCompared, reportDir.getFullPathName().toRawUTF8());
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    auto usage = [&] {
+        std::fprintf(stderr, "usage: %s record <dir>\n"
+                             "       %s compare <dir> [--ulps n] [--floor dB] [--report dir] [--only name]\n",
+                     argv[0], argv[0]);
+        return 2;
+    };
+
+    if (argc < 3) {
+        return usage();
+    }
+
+    juce::String command(argv[1]);
+    auto dir = getFile(argv[2]);
+
+    int64_t allowedUlps = 256;
+    float floorDb = -120.0f;
+    auto reportDir = juce::File::getCurrentWorkingDirectory();
+    juce::String only;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        juce::String option(argv[i]);
+        juce::String value(argv[i + 1]);
+        if (option == "--ulps")        allowedUlps = value.getLargeIntValue();
+        else if (option == "--floor")  floorDb = value.getFloatValue();
+        else if (option == "--report") reportDir = getFile(value);
+        else if (option == "--only")   only = value;
+        else return usage();
+    }
+    if ((argc - 3) % 2 != 0) {
+        return usage();
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    int result = 0;
+    if (command == "record") {
+        result = record(dir);
+    } else if (command == "compare") {
+        result = compareAll(dir, reportDir, allowedUlps, floorDb, only);
+    } else {
+        return usage();
+    }
+
+    if (numRealtimeViolations > 0) {
+        std::fprintf(stderr, "\n%d real-time violations in processBlock\n", numRealtimeViolations);
+        return std::max(result, 1);
+    }
+    return result;
+}
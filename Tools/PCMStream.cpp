@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    PCMStream.cpp
+    Created: 19 Oct 2026 3:17:02am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "PCMStream.h"
+
+#ifdef _WIN32
+ #include <fcntl.h>
+ #include <io.h>
+#endif
+
+namespace PCMStream
+{
+
+bool parseFormat(const char* name, Format& format)
+{
+    if (std::strcmp(name, "f32") == 0) {
+        format = Format::float32;
+        return true;
+    }
+    if (std::strcmp(name, "s16") == 0) {
+        format = Format::int16;
+        return true;
+    }
+    return false;
+}
+
+int getBytesPerSample(Format format) noexcept
+{
+    return format == Format::float32 ? 4 : 2;
+}
+
+void setBinaryMode([[maybe_unused]] std::FILE* file)
+{
+   #ifdef _WIN32
+    _setmode(_fileno(file), _O_BINARY);
+   #endif
+}
+
+Reader::Reader(std::FILE* file_, Format format_, int numChannels_, int maxFrames) :
+    file(file_), format(format_), numChannels(numChannels_),
+    frameSize(size_t(numChannels_) * size_t(getBytesPerSample(format_)))
+{
+    for (auto& buffer : buffers) {
+        buffer.bytes.resize(frameSize * size_t(maxFrames));
+    }
+    reader = std::thread([this] { readerLoop(); });
+}
+
+Reader::~Reader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    changed.notify_all();
+    reader.join();
+}
+
+int Reader::read(float* const* channels)
+{
+    auto& buffer = buffers[next];
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return buffer.full || finished; });
+        if (!buffer.full) {
+            return 0;
+        }
+    }
+
+    // the reader thread leaves a full buffer alone
+    int numFrames = int(buffer.size / frameSize);
+    deinterleave(buffer, channels, numFrames);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer.full = false;
+    }
+    changed.notify_all();
+    next ^= 1;
+    return numFrames;
+}
+
+bool Reader::hasError() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+void Reader::readerLoop()
+{
+    for (int index = 0;; index ^= 1) {
+        auto& buffer = buffers[index];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return !buffer.full || quit; });
+            if (quit) {
+                return;
+            }
+        }
+
+        // fread returns short on a pipe that has less waiting, keep going until the block is full
+        size_t capacity = buffer.bytes.size();
+        size_t size = 0;
+        while (size < capacity) {
+            size_t count = std::fread(buffer.bytes.data() + size, 1, capacity - size, file);
+            if (count == 0) {
+                break;
+            }
+            size += count;
+        }
+        bool ended = size < capacity;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffer.size = size - size % frameSize;
+            buffer.full = buffer.size > 0;
+            finished = ended;
+            error = ended && std::ferror(file) != 0;
+        }
+        changed.notify_all();
+
+        if (ended) {
+            return;
+        }
+    }
+}
+
+void Reader::deinterleave(const Buffer& buffer, float* const* channels, int numFrames) const
+{
+    const unsigned char* bytes = buffer.bytes.data();
+    if (format == Format::float32) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const unsigned char* source = bytes + channel * 4;
+            float* dest = channels[channel];
+            for (int i = 0; i < numFrames; ++i) {
+                std::memcpy(dest + i, source + size_t(i) * frameSize, 4);
+            }
+        }
+    } else {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const unsigned char* source = bytes + channel * 2;
+            float* dest = channels[channel];
+            for (int i = 0; i < numFrames; ++i) {
+                int16_t sample;
+                std::memcpy(&sample, source + size_t(i) * frameSize, 2);
+                dest[i] = float(sample) * (1.0f / 32768.0f);
+            }
+        }
+    }
+}
+
+Writer::Writer(std::FILE* file_, Format format_, int numChannels_, int maxFrames) :
+    file(file_), format(format_), numChannels(numChannels_),
+    frameSize(size_t(numChannels_) * size_t(getBytesPerSample(format_))),
+    bytes(frameSize * size_t(maxFrames))
+{
+}
+
+bool Writer::write(const float* const* channels, int numFrames)
+{
+    unsigned char* data = bytes.data();
+    if (format == Format::float32) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            unsigned char* dest = data + channel * 4;
+            const float* source = channels[channel];
+            for (int i = 0; i < numFrames; ++i) {
+                std::memcpy(dest + size_t(i) * frameSize, source + i, 4);
+            }
+        }
+    } else {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            unsigned char* dest = data + channel * 2;
+            const float* source = channels[channel];
+            for (int i = 0; i < numFrames; ++i) {
+                // the inverse of read(), so 16 bit in comes out bit for bit when nothing changes it
+                auto sample = int16_t(std::clamp(std::lrint(source[i] * 32768.0f), -32768L, 32767L));
+                std::memcpy(dest + size_t(i) * frameSize, &sample, 2);
+            }
+        }
+    }
+
+    size_t size = frameSize * size_t(numFrames);
+    return std::fwrite(data, 1, size, file) == size;
+}
+
+}  // namespace PCMStream
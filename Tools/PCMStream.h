@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    PCMStream.h
+    Created: 19 Oct 2026 3:17:02am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Raw interleaved PCM in the machine's byte order, as pipes between audio tools carry it. The
+// Reader reads ahead on a thread of its own into one of two buffers while the other one is
+// deinterleaved, so the file (stdin, usually) is read while the previous block is processed.
+// Samples go from the bytes that were read straight into the channels the caller processes,
+// and from those straight into the bytes that are written.
+//
+// No JUCE in here, like AutomationLog.
+namespace PCMStream
+{
+    enum class Format { float32, int16 };
+
+    // "f32" or "s16"
+    bool parseFormat(const char* name, Format& format);
+
+    int getBytesPerSample(Format format) noexcept;
+
+    // Switches a stream to binary, where that's a thing (Windows)
+    void setBinaryMode(std::FILE* file);
+
+    class Reader
+    {
+    public:
+        // Reads blocks of up to maxFrames frames from file until it ends
+        Reader(std::FILE* file, Format format, int numChannels, int maxFrames);
+        ~Reader();
+
+        // Waits for the next block and deinterleaves it into channels, which must have room
+        // for maxFrames samples each. Returns the number of frames, 0 once the file has ended.
+        // A block is only short at the end, where a frame that was cut off is left out.
+        int read(float* const* channels);
+
+        // Whether reading stopped because of an error rather than the end of the file
+        bool hasError() const;
+
+    private:
+        struct Buffer
+        {
+            std::vector<unsigned char> bytes;
+            size_t size = 0;
+            bool full = false;  // read and waiting for read()
+        };
+
+        void readerLoop();
+        void deinterleave(const Buffer& buffer, float* const* channels, int numFrames) const;
+
+        std::FILE* file;
+        Format format;
+        int numChannels;
+        size_t frameSize;
+
+        Buffer buffers[2];
+        int next = 0;  // the buffer read() takes next
+
+        mutable std::mutex mutex;
+        std::condition_variable changed;
+        bool finished = false;  // the reader thread has read the last buffer
+        bool error = false;
+        bool quit = false;
+
+        std::thread reader;
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+    };
+
+    class Writer
+    {
+    public:
+        Writer(std::FILE* file, Format format, int numChannels, int maxFrames);
+
+        // Interleaves numFrames frames of the channels and writes them. False when the file
+        // can't take them (the other end of the pipe has gone, say).
+        bool write(const float* const* channels, int numFrames);
+
+    private:
+        std::FILE* file;
+        Format format;
+        int numChannels;
+        size_t frameSize;
+        std::vector<unsigned char> bytes;
+    };
+}
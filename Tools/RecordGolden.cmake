@@ -0,0 +1,80 @@
+# Records the golden output references from a commit rather than from the working tree, so the
+# same references can be recorded again anywhere. Run by the BrocDelayGoldenRecord target:
+#
+#   cmake -DREF=<commit> -DSOURCE_DIR=<repository> -DWORK_DIR=<scratch dir> -DOUTPUT_DIR=<dir>
+#         -DJUCE_DIR=<JUCE checkout> -P RecordGolden.cmake
+#
+# The commit is exported with git archive (uncommitted changes don't count), built on its own in
+# WORK_DIR, and its BrocDelayGoldenOutput records into OUTPUT_DIR. The commit it resolved to is
+# written to OUTPUT_DIR/baseline.txt. Commits from before Tools/GoldenOutput.cpp existed get
+# the tool from next to this script instead, built with GoldenBaseline.cmake.
+
+cmake_minimum_required(VERSION 3.22)
+
+foreach(variable REF SOURCE_DIR WORK_DIR OUTPUT_DIR JUCE_DIR)
+    if(NOT DEFINED ${variable})
+        message(FATAL_ERROR "RecordGolden.cmake needs -D${variable}=...")
+    endif()
+endforeach()
+
+if(NOT EXISTS "${JUCE_DIR}/CMakeLists.txt")
+    message(FATAL_ERROR "No JUCE checkout at ${JUCE_DIR}, the golden output tool needs one")
+endif()
+
+find_package(Git REQUIRED)
+
+execute_process(
+    COMMAND "${GIT_EXECUTABLE}" -C "${SOURCE_DIR}" rev-parse --verify "${REF}^{commit}"
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    COMMAND_ERROR_IS_FATAL ANY)
+message(STATUS "Recording the golden output of ${REF} (${commit})")
+
+set(source "${WORK_DIR}/source")
+set(build "${WORK_DIR}/build")
+file(REMOVE_RECURSE "${source}")
+file(MAKE_DIRECTORY "${source}")
+
+execute_process(
+    COMMAND "${GIT_EXECUTABLE}" -C "${SOURCE_DIR}" archive --format=tar -o "${WORK_DIR}/source.tar" "${commit}"
+    COMMAND_ERROR_IS_FATAL ANY)
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E tar xf "${WORK_DIR}/source.tar"
+    WORKING_DIRECTORY "${source}"
+    COMMAND_ERROR_IS_FATAL ANY)
+file(REMOVE "${WORK_DIR}/source.tar")
+
+if(NOT EXISTS "${source}/Tools/GoldenOutput.cpp")
+    message(STATUS "${REF} has no golden output tool, recording with the one next to RecordGolden.cmake")
+    set(tools "${CMAKE_CURRENT_LIST_DIR}")
+    file(COPY "${tools}/GoldenOutput.cpp" "${tools}/ScriptedPlayHead.h" "${tools}/ScriptedPlayHead.cpp"
+        DESTINATION "${source}/Tools")
+    foreach(file RealtimeCheck.h RealtimeCheck.cpp)
+        if(NOT EXISTS "${source}/Source/${file}")
+            file(COPY "${tools}/../Source/${file}" DESTINATION "${source}/Source")
+        endif()
+    endforeach()
+    # whatever CMakeLists.txt the commit has doesn't know about the tool
+    file(COPY_FILE "${tools}/GoldenBaseline.cmake" "${source}/CMakeLists.txt")
+endif()
+
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -S "${source}" -B "${build}" -DCMAKE_BUILD_TYPE=Release
+            "-DBROCDELAY_JUCE_DIR=${JUCE_DIR}"
+    COMMAND_ERROR_IS_FATAL ANY)
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" --build "${build}" --config Release --target BrocDelayGoldenOutput
+    COMMAND_ERROR_IS_FATAL ANY)
+
+file(GLOB_RECURSE tool LIST_DIRECTORIES false
+    "${build}/BrocDelayGoldenOutput" "${build}/BrocDelayGoldenOutput.exe")
+if(NOT tool)
+    message(FATAL_ERROR "BrocDelayGoldenOutput wasn't built in ${build}")
+endif()
+list(GET tool 0 tool)
+
+file(REMOVE_RECURSE "${OUTPUT_DIR}")
+execute_process(
+    COMMAND "${tool}" record "${OUTPUT_DIR}"
+    COMMAND_ERROR_IS_FATAL ANY)
+file(WRITE "${OUTPUT_DIR}/baseline.txt" "${commit}\n")
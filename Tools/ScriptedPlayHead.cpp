@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    ScriptedPlayHead.cpp
+    Created: 19 Oct 2026 1:34:12am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#include "ScriptedPlayHead.h"
+#include <algorithm>
+#include <cmath>
+
+ScriptedPlayHead::ScriptedPlayHead(double sampleRate_) : sampleRate(sampleRate_)
+{
+    jassert(sampleRate > 0.0);
+    reset();
+}
+
+juce::Result ScriptedPlayHead::setScript(const juce::String& script)
+{
+    struct CommandInfo
+    {
+        const char* name;
+        Command command;
+        int numValues;
+    };
+    static const CommandInfo commands[] = {
+        { "tempo", Command::tempo, 1 },
+        { "ramp", Command::ramp, 2 },
+        { "notempo", Command::noTempo, 0 },
+        { "loop", Command::loop, 2 },
+        { "noloop", Command::noLoop, 0 },
+        { "stop", Command::stop, 0 },
+        { "play", Command::play, 0 },
+        { "seek", Command::seek, 1 },
+        { "noposition", Command::noPosition, 0 },
+        { "position", Command::position, 0 }
+    };
+
+    auto isNumber = [] (const juce::String& text) {
+        return text.isNotEmpty() && text.containsOnly("0123456789.");
+    };
+    auto toSamples = [this] (double seconds) {
+        return int64_t(std::llround(seconds * sampleRate));
+    };
+
+    std::vector<Event> parsed;
+    int64_t repeat = 0;
+
+    auto lines = juce::StringArray::fromLines(script.replaceCharacter(';', '\n'));
+    for (int i = 0; i < lines.size(); ++i) {
+        auto line = lines[i].upToFirstOccurrenceOf("#", false, false).trim();
+        if (line.isEmpty()) {
+            continue;
+        }
+        auto fail = [&] (const juce::String& message) {
+            return juce::Result::fail("transport script, command " + juce::String(i + 1) + " (" + line + "): " + message);
+        };
+
+        auto tokens = juce::StringArray::fromTokens(line, " \t", "");
+        tokens.removeEmptyStrings();
+
+        if (tokens[0] == "repeat") {
+            if (tokens.size() != 2 || !isNumber(tokens[1]) || toSamples(tokens[1].getDoubleValue()) <= 0) {
+                return fail("expected repeat <seconds>");
+            }
+            repeat = toSamples(tokens[1].getDoubleValue());
+            continue;
+        }
+
+        if (tokens.size() < 2 || !isNumber(tokens[0])) {
+            return fail("expected <seconds> <command>");
+        }
+
+        const CommandInfo* info = nullptr;
+        for (const auto& command : commands) {
+            if (tokens[1] == command.name) {
+                info = &command;
+            }
+        }
+        if (info == nullptr) {
+            return fail("unknown command " + tokens[1]);
+        }
+        if (tokens.size() != 2 + info->numValues) {
+            return fail(tokens[1] + " takes " + juce::String(info->numValues) + " values");
+        }
+        for (int v = 2; v < tokens.size(); ++v) {
+            if (!isNumber(tokens[v])) {
+                return fail(tokens[v] + " isn't a number");
+            }
+        }
+
+        Event event { toSamples(tokens[0].getDoubleValue()), info->command,
+                      tokens[2].getDoubleValue(), tokens[3].getDoubleValue() };
+        if ((event.command == Command::tempo || event.command == Command::ramp) && event.value <= 0.0) {
+            return fail("the tempo must be above 0");
+        }
+        if (event.command == Command::loop && toSamples(event.value2) <= toSamples(event.value)) {
+            return fail("the loop must end after it starts");
+        }
+        parsed.push_back(event);
+    }
+
+    for (const auto& event : parsed) {
+        if (repeat > 0 && event.time >= repeat) {
+            return juce::Result::fail("transport script: a command comes after the repeat");
+        }
+    }
+
+    // commands at the same time happen in the order they were written
+    std::stable_sort(parsed.begin(), parsed.end(), [] (const Event& a, const Event& b) {
+        return a.time < b.time;
+    });
+
+    events = std::move(parsed);
+    repeatLength = repeat;
+    reset();
+    return juce::Result::ok();
+}
+
+void ScriptedPlayHead::reset()
+{
+    renderPosition = 0;
+    cycleStart = 0;
+    timeInSamples = 0;
+    ppqPosition = 0.0;
+    bpm = 120.0;
+    hasTempo = true;
+    isPlaying = true;
+    hasPosition = true;
+    isLooping = false;
+    loopStart = 0;
+    loopEnd = 0;
+    rampLength = 0;
+
+    applyEvents(-1, 0);
+}
+
+void ScriptedPlayHead::advance(int numSamples)
+{
+    jassert(numSamples >= 0);
+
+    moveTransport(numSamples);
+
+    int64_t from = renderPosition - cycleStart;
+    renderPosition += numSamples;
+
+    // blocks longer than the repeat go round more than once
+    while (repeatLength > 0 && renderPosition - cycleStart >= repeatLength) {
+        applyEvents(from, repeatLength - 1);
+        cycleStart += repeatLength;
+        from = -1;
+    }
+    applyEvents(from, renderPosition - cycleStart);
+
+    if (rampLength > 0) {
+        double progress = std::min(1.0, double(renderPosition - rampStart) / double(rampLength));
+        bpm = rampFrom + (rampTo - rampFrom) * progress;
+        if (progress >= 1.0) {
+            rampLength = 0;
+        }
+    }
+}
+
+juce::Optional<juce::AudioPlayHead::PositionInfo> ScriptedPlayHead::getPosition() const
+{
+    if (!hasPosition) {
+        return {};
+    }
+
+    auto toPpq = [this] (int64_t time) {
+        return ppqPosition + double(time - timeInSamples) / sampleRate * bpm / 60.0;
+    };
+
+    PositionInfo info;
+    if (hasTempo) {
+        info.setBpm(bpm);
+    }
+    info.setTimeSignature(TimeSignature {});
+    info.setTimeInSamples(timeInSamples);
+    info.setTimeInSeconds(double(timeInSamples) / sampleRate);
+    info.setPpqPosition(ppqPosition);
+    info.setPpqPositionOfLastBarStart(std::floor(ppqPosition / 4.0) * 4.0);
+    info.setIsPlaying(isPlaying);
+    info.setIsLooping(isLooping);
+    if (isLooping) {
+        info.setLoopPoints(LoopPoints { toPpq(loopStart), toPpq(loopEnd) });
+    }
+    return info;
+}
+
+void ScriptedPlayHead::applyEvents(int64_t from, int64_t to)
+{
+    for (const auto& event : events) {
+        if (event.time > from && event.time <= to) {
+            apply(event);
+        }
+    }
+}
+
+void ScriptedPlayHead::apply(const Event& event)
+{
+    auto toSamples = [this] (double seconds) {
+        return int64_t(std::llround(seconds * sampleRate));
+    };
+    auto moveTo = [this] (int64_t time) {
+        ppqPosition += double(time - timeInSamples) / sampleRate * bpm / 60.0;
+        timeInSamples = time;
+    };
+
+    switch (event.command) {
+        case Command::tempo:
+            bpm = event.value;
+            hasTempo = true;
+            rampLength = 0;
+            break;
+        case Command::ramp:
+            rampFrom = bpm;
+            rampTo = event.value;
+            rampStart = cycleStart + event.time;
+            rampLength = toSamples(event.value2);
+            hasTempo = true;
+            if (rampLength == 0) {
+                bpm = rampTo;
+            }
+            break;
+        case Command::noTempo:
+            hasTempo = false;
+            rampLength = 0;
+            break;
+        case Command::loop:
+            isLooping = true;
+            loopStart = toSamples(event.value);
+            loopEnd = toSamples(event.value2);
+            break;
+        case Command::noLoop:
+            isLooping = false;
+            break;
+        case Command::stop:
+            isPlaying = false;
+            break;
+        case Command::play:
+            isPlaying = true;
+            break;
+        case Command::seek:
+            moveTo(toSamples(event.value));
+            break;
+        case Command::noPosition:
+            hasPosition = false;
+            break;
+        case Command::position:
+            hasPosition = true;
+            break;
+    }
+}
+
+void ScriptedPlayHead::moveTransport(int64_t numSamples)
+{
+    if (!isPlaying) {
+        return;
+    }
+
+    int64_t time = timeInSamples + numSamples;
+
+    // like a host that doesn't split blocks at the loop end
+    if (isLooping && timeInSamples < loopEnd && time >= loopEnd) {
+        time = loopStart + (time - loopEnd) % (loopEnd - loopStart);
+    }
+
+    ppqPosition += double(time - timeInSamples) / sampleRate * bpm / 60.0;
+    timeInSamples = time;
+}
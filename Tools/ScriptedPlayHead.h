@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    ScriptedPlayHead.h
+    Created: 19 Oct 2026 1:34:12am
+    Author:  Brett
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+// A host transport for the headless tools that follows a script, so tempo changes, loops,
+// stops and seeks can be rendered without a DAW. One command per line (or separated by ";"),
+// each starting with the time in seconds of rendered audio it happens at:
+//
+//   0    tempo 120        report 120 bpm (the start: playing from 0 at 120 bpm, no loop)
+//   1    ramp 90 2        glide to 90 bpm over 2 seconds
+//   1    notempo          stop reporting a tempo, like some hosts do
+//   2    loop 0.5 1.5     loop the transport between 0.5 and 1.5 seconds
+//   3    noloop
+//   4    stop             the transport stops where it is, rendering goes on
+//   4.5  play
+//   5    seek 0.25        the transport jumps
+//   6    noposition       getPosition() has nothing at all, until "position"
+//        repeat 8         start the script over every 8 seconds
+//
+// "#" starts a comment. Like a host, it reports the position of the start of each block, so
+// a command takes effect from the first block that starts at or after its time. The ppq
+// position moves with the transport at the current tempo.
+class ScriptedPlayHead : public juce::AudioPlayHead
+{
+public:
+    explicit ScriptedPlayHead(double sampleRate);
+
+    // Replaces the script and starts it from the beginning
+    juce::Result setScript(const juce::String& script);
+
+    // Back to the start of the script
+    void reset();
+
+    // Call after every processBlock: moves the transport on by the block that was just
+    // rendered and applies what the script has for the start of the next one.
+    void advance(int numSamples);
+
+    juce::Optional<PositionInfo> getPosition() const override;
+
+    int64_t getTimeInSamples() const noexcept
+    {
+        return timeInSamples;
+    }
+
+    double getSampleRate() const noexcept
+    {
+        return sampleRate;
+    }
+
+private:
+    enum class Command { tempo, ramp, noTempo, loop, noLoop, stop, play, seek, noPosition, position };
+
+    struct Event
+    {
+        int64_t time;  // in rendered samples, from the start of the script
+        Command command;
+        double value;
+        double value2;
+    };
+
+    // Applies the events with from < time <= to, in script time
+    void applyEvents(int64_t from, int64_t to);
+    void apply(const Event& event);
+    void moveTransport(int64_t numSamples);
+
+    double sampleRate;
+    std::vector<Event> events;
+    int64_t repeatLength = 0;  // 0 for a script that runs once
+
+    int64_t renderPosition = 0;  // samples rendered since reset()
+    int64_t cycleStart = 0;      // renderPosition where the script last started over
+
+    int64_t timeInSamples = 0;
+    double ppqPosition = 0.0;
+    double bpm = 120.0;
+    bool hasTempo = true;
+    bool isPlaying = true;
+    bool hasPosition = true;
+    bool isLooping = false;
+    int64_t loopStart = 0;
+    int64_t loopEnd = 0;
+
+    // the ramp in progress, rampLength 0 if there's none
+    int64_t rampStart = 0;
+    int64_t rampLength = 0;
+    double rampFrom = 0.0;
+    double rampTo = 0.0;
+};